@@ -0,0 +1,81 @@
+#include "gel/allocation_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "gel/lambda.h"
+#include "gel/runtime.h"
+#include "gel/script.h"
+#include "gel/stack_frame.h"
+
+namespace gel {
+DEFINE_uword(allocation_sample_interval, 0,
+             "The average number of bytes allocated between allocation samples, 0 disables the allocation profiler.");
+
+AllocationProfiler::AllocationProfiler(const uword interval) :
+  interval_(interval),
+  remaining_(0),
+  distribution_(1.0 / static_cast<double>(interval)) {
+  ASSERT(interval > 0);
+  remaining_ = NextInterval();
+}
+
+auto AllocationProfiler::NextInterval() -> word {
+  return std::max(static_cast<word>(distribution_(random_)), static_cast<word>(1));
+}
+
+static inline auto GetCodeOffset(const Executable* exec, const uword address) -> std::string {
+  const auto& code = exec->GetCode();
+  if (!code.IsAllocated() || address < code.GetStartingAddress() || address >= code.GetEndingAddress())
+    return "";
+  return fmt::format("+{}", address - code.GetStartingAddress());
+}
+
+auto AllocationProfiler::GetStackTrace() -> std::string {
+  const auto runtime = GetRuntime();
+  if (!runtime || runtime->frames_.empty())
+    return "<root>";
+  std::vector<std::string> frames{};
+  // each frame's return address is the position its caller was suspended at
+  auto address = runtime->interpreter_.GetCurrentAddress();
+  StackFrameIterator iter(runtime->frames_);
+  while (iter.HasNext()) {
+    const auto frame = iter.Next();
+    auto name = frame.GetTargetName();
+    if (frame.IsLambdaFrame()) {
+      name += GetCodeOffset(frame.GetLambda(), address);
+    } else if (frame.IsScriptFrame()) {
+      name += GetCodeOffset(frame.GetScript(), address);
+    }
+    std::replace(name.begin(), name.end(), ';', ':');
+    std::replace(name.begin(), name.end(), ' ', '_');
+    frames.push_back(name);
+    address = frame.GetReturnAddress();
+  }
+  std::stringstream ss;
+  for (auto iter = frames.rbegin(); iter != frames.rend(); iter++)
+    ss << (iter == frames.rbegin() ? "" : ";") << (*iter);
+  return ss.str();
+}
+
+void AllocationProfiler::Sample(const char* type, const uword size) {
+  ASSERT(size > 0);
+  // an object of `size` bytes is sampled w/ a probability of 1 - e^(-size/interval), scaling by its inverse keeps the
+  // estimates unbiased
+  const auto probability = 1.0 - std::exp(-static_cast<double>(size) / static_cast<double>(GetInterval()));
+  const auto num_objects = std::max(static_cast<uword>(std::llround(1.0 / probability)), static_cast<uword>(1));
+  auto& site = sites_[fmt::format("{};{}", GetStackTrace(), type ? type : "<unknown>")];
+  site.num_samples += 1;
+  site.num_objects += num_objects;
+  site.num_bytes += num_objects * size;
+  num_samples_ += 1;
+  remaining_ = NextInterval();
+}
+
+void AllocationProfiler::ToCollapsedStacks(std::ostream& stream) const {
+  for (const auto& [stack, site] : GetSites())
+    stream << stack << " " << site.num_bytes << std::endl;
+}
+}  // namespace gel
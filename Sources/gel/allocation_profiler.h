@@ -0,0 +1,89 @@
+#ifndef GEL_ALLOCATION_PROFILER_H
+#define GEL_ALLOCATION_PROFILER_H
+
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "gel/common.h"
+#include "gel/flags.h"
+
+namespace gel {
+DECLARE_uword(allocation_sample_interval);
+
+static inline auto GetAllocationSampleInterval() -> uword {
+  return FLAGS_allocation_sample_interval;
+}
+
+static inline auto IsAllocationProfilerEnabled() -> bool {
+  return GetAllocationSampleInterval() > 0;
+}
+
+// the sampled allocations of a single type from a single stack.
+struct AllocationSite {
+  DEFINE_DEFAULT_COPYABLE_TYPE(AllocationSite);
+
+ public:
+  uword num_samples = 0;
+  uword num_objects = 0;  // estimated from the samples
+  uword num_bytes = 0;    // estimated from the samples
+
+  AllocationSite() = default;
+  ~AllocationSite() = default;
+};
+
+// samples an allocation every `--allocation_sample_interval` bytes on average & attributes it to the Runtime's stack
+// at the time, the intervals are drawn from an exponential distribution so the samples aren't biased by object size.
+class AllocationProfiler {
+  DEFINE_NON_COPYABLE_TYPE(AllocationProfiler);
+
+ public:
+  using SiteMap = std::unordered_map<std::string, AllocationSite>;
+
+ private:
+  uword interval_;
+  word remaining_;  // the bytes left to allocate until the next sample
+  std::mt19937_64 random_{};
+  std::exponential_distribution<double> distribution_;
+  SiteMap sites_{};
+  uword num_samples_ = 0;
+
+  auto NextInterval() -> word;
+  // the Runtime's StackFrames from the outermost inwards in the collapsed stack format, w/ the offset into the code of
+  // each Lambda & Script frame.
+  static auto GetStackTrace() -> std::string;
+
+ public:
+  explicit AllocationProfiler(const uword interval = GetAllocationSampleInterval());
+  ~AllocationProfiler() = default;
+
+  auto GetInterval() const -> uword {
+    return interval_;
+  }
+
+  auto GetNumberOfSamples() const -> uword {
+    return num_samples_;
+  }
+
+  auto GetSites() const -> const SiteMap& {
+    return sites_;
+  }
+
+  auto GetBytesUntilSample() const -> uword {
+    return remaining_ > 0 ? static_cast<uword>(remaining_) : 0;
+  }
+
+  // counts `size` bytes as allocated, returns true once a sample is due.
+  inline auto Consume(const uword size) -> bool {
+    remaining_ -= static_cast<word>(size);
+    return remaining_ <= 0;
+  }
+
+  void Sample(const char* type, const uword size);
+  // writes a line of `frame;...;frame;type bytes` per site, as read by flamegraph.pl & speedscope.
+  void ToCollapsedStacks(std::ostream& stream) const;
+};
+}  // namespace gel
+
+#endif  // GEL_ALLOCATION_PROFILER_H
@@ -1,5 +1,6 @@
 #include "gel/array.h"
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/heap.h"
 #include "gel/runtime.h"
@@ -14,10 +15,8 @@ auto ArrayBase::operator new(const size_t sz, const uword cap) -> void* {
 #else
 
 auto ArrayBase::operator new(const size_t sz, const uword cap) -> void* {
-  const auto heap = Heap::GetHeap();
-  ASSERT(heap);
   const auto total_size = sz + sizeof(uword) * cap;
-  const auto address = heap->TryAllocate(total_size);
+  const auto address = Heap::Allocate(total_size, "Array");
   ASSERT(address != UNALLOCATED);
   return (void*)address;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
 }
@@ -29,6 +28,7 @@ void ArrayBase::InitClass() {
   ASSERT(kClass == nullptr);
   kClass = CreateClass();
   ASSERT(kClass);
+  AddRoot(&kClass);
 }
 
 auto ArrayBase::HashCode() const -> uword {
@@ -79,6 +79,13 @@ auto ArrayBase::VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool
   return true;
 }
 
+auto ArrayBase::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return VisitPointers([vis](Pointer** ptr) {
+    return vis->Visit(ptr);
+  });
+}
+
 void ArrayBase::Init() {
   InitClass();
   InitNative<proc::array_new>();
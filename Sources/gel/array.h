@@ -75,6 +75,7 @@ class ArrayBase : public Object {
   }
 
   auto VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool;
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
   auto GetPointerAt(const uword idx) const -> Pointer** {
     ASSERT(idx >= 0 && idx <= GetCapacity());
@@ -105,7 +106,9 @@ class ArrayBase : public Object {
   void Set(const uword idx, Object* value) {
     ASSERT(value);
     ASSERT(idx >= 0 && idx <= GetCapacity());
+    gel::PreWriteBarrier(*GetPointerAt(idx));
     (*GetPointerAt(idx)) = value->raw_ptr();
+    WriteBarrier(value);
   }
 
   auto operator[](const uword idx) const -> uword& {
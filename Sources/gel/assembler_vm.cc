@@ -1,5 +1,6 @@
 #include "gel/assembler.h"
 #include "gel/bytecode.h"
+#include "gel/collector.h"
 #include "gel/memory_region.h"
 
 namespace gel {
@@ -23,6 +24,9 @@ void Assembler::EmitLabelLink(Label* label) {
 auto Assembler::Assemble() const -> Region {
   MemoryRegion region(cbuffer().GetSize(), MemoryRegion::kReadWrite);
   region.CopyFrom(cbuffer().GetStartingAddress(), cbuffer().GetSize());
+  // code is never freed, the Objects it references are roots & get patched in place when they move
+  for (const auto& offset : objects_)
+    AddRoot((Object**)(region.GetStartingAddress() + offset));  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
   return {region};
 }
 
@@ -22,6 +22,7 @@ class Assembler {
 
  private:
   AssemblerBuffer buffer_{};
+  std::vector<uword> objects_{};  // offsets of the Object immediates
 
   auto buffer() -> AssemblerBuffer& {
     return buffer_;
@@ -73,6 +74,7 @@ class Assembler {
 
   template <class T>
   inline void EmitAddress(const T* value) {
+    objects_.push_back(cbuffer().GetSize());
     return Emit(value->GetStartingAddress());
   }
 
@@ -146,7 +148,8 @@ class Assembler {
       return pusht();
     else if (value->IsBool() && !value->AsBool()->Get())
       return pushf();
-    return pushq(value->GetStartingAddress());
+    EmitOp(Bytecode::kPushQ);
+    return EmitAddress(value);
   }
 
   inline void lookup() {
@@ -160,6 +163,14 @@ class Assembler {
     Emit(num_args);
   }
 
+  // calls `func` in place of the current Lambda, see Runtime::TailCallWithNArgs.
+  inline void tailinvoke(Lambda* func, const uword num_args) {
+    ASSERT(func);
+    EmitOp(Bytecode::kTailInvoke);
+    EmitAddress(func);
+    Emit(num_args);
+  }
+
   inline void invokedynamic(const uword num_args) {
     EmitOp(Bytecode::kInvokeDynamic);
     Emit(num_args);
@@ -17,19 +17,15 @@ auto Buffer::operator new(const size_t sz, const uword capacity) -> void* {
 #else
 
 auto Buffer::operator new(const size_t sz, const uword capacity) -> void* {
-  const auto heap = Heap::GetHeap();
-  ASSERT(heap);
   const auto total_size = sz + (sizeof(uint8_t) * capacity);
-  const auto address = heap->TryAllocate(total_size);
+  const auto address = Heap::Allocate(total_size, kClassName);
   ASSERT(address != UNALLOCATED);
   return (void*)address;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
 }
 
 #define DEFINE_NEW_OPERATOR(Name)                     \
   auto Name::operator new(const size_t sz) -> void* { \
-    const auto heap = Heap::GetHeap();                \
-    ASSERT(heap);                                     \
-    const auto address = heap->TryAllocate(sz);       \
+    const auto address = Heap::Allocate(sz);          \
     ASSERT(address != UNALLOCATED);                   \
     return reinterpret_cast<void*>(address);          \
   }
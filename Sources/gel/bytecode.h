@@ -23,6 +23,7 @@
   V(Invoke)                  \
   V(InvokeDynamic)           \
   V(InvokeNative)            \
+  V(TailInvoke)              \
   V(CheckInstance)           \
   V(Ret)                     \
   V(PushQ)                   \
@@ -143,6 +144,8 @@ class Bytecode {
         return "invokedynamic";
       case kInvokeNative:
         return "invokenative";
+      case kTailInvoke:
+        return "tailinvoke";
       case kRet:
         return "ret";
       case kThrow:
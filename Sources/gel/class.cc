@@ -10,6 +10,7 @@
 #include "gel/pointer.h"
 #include "gel/script.h"
 #include "gel/to_string_helper.h"
+#include "gel/weak_ref.h"
 
 namespace gel {
 static uword num_classes_ = 0;
@@ -71,29 +72,27 @@ auto Class::ToString() const -> std::string {
   return helper;
 }
 
-auto Class::GetAllocationSize() const -> uword {
-  if (Equals(Class::kClass))
-    return sizeof(Class);
-  else if (Equals(Field::kClass))
-    return sizeof(Field);
-  else if (Equals(String::kClass))
-    return sizeof(String);
-  else if (Equals(Module::kClass)) {
-    const auto cls = Module::GetClass();
-    ASSERT(cls);
-    uword total_size = sizeof(Module);
-    for (const auto& field : cls->GetFields()) {
-      ASSERT(field);
-      field->SetOffset(total_size);
-      total_size += sizeof(uword);
-    }
-    return total_size;
+void Class::LayoutField(Field* field) {
+  ASSERT(field && field->IsInstance());
+  field->SetOffset(allocation_size_);
+  field_offsets_.push_back(allocation_size_);
+  allocation_size_ += sizeof(Object*);
+}
+
+void Class::Finalize(const uword size) {
+  ASSERT(!IsFinalized());
+  ASSERT(size > 0);
+  allocation_size_ = size;
+  for (const auto& field : fields_) {
+    ASSERT(field);
+    if (field->IsInstance())
+      LayoutField(field);
   }
-  return 0;
 }
 
 auto Class::AddField(const std::string& name) -> Field* {
   ASSERT(!name.empty());
+  LOG_IF(FATAL, IsFinalized()) << "cannot add field `" << name << "` to finalized " << ToString();
   const auto field = Field::New(this, String::New(name));
   ASSERT(field);
   Add(field);
@@ -108,7 +107,16 @@ auto Class::VisitPointers(PointerVisitor* vis) -> bool {
 
 auto Class::VisitPointers(PointerPointerVisitor* vis) -> bool {
   ASSERT(vis);
-  NOT_IMPLEMENTED(ERROR);  // TODO: implement
+  if (!VisitPointer(vis, &parent_) || !VisitPointer(vis, &name_))
+    return false;
+  for (auto& func : funcs_) {
+    if (!VisitPointer(vis, &func))
+      return false;
+  }
+  for (auto& field : fields_) {
+    if (!VisitPointer(vis, &field))
+      return false;
+  }
   return true;
 }
 
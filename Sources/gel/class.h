@@ -53,6 +53,8 @@ class Class : public Object {
     kExpressionClassId,
     kEventLoopClassId,
     kTimerClassId,
+    kWeakRefClassId,
+    kWeakMapClassId,
     kObservableClassId,
     kObserverClassId,
     kSubjectClassId,
@@ -67,6 +69,10 @@ class Class : public Object {
   String* name_;
   std::vector<Procedure*> funcs_{};
   std::vector<Field*> fields_{};
+  uword allocation_size_ = 0;          // the size of an instance, computed once by Finalize
+  std::vector<uword> field_offsets_{};  // the offsets of the Object* instance fields laid out after the native object
+
+  void LayoutField(Field* field);
 
  protected:
   explicit Class(ClassId id, Class* parent, String* name) :
@@ -83,6 +89,10 @@ class Class : public Object {
  public:
   ~Class() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto GetClassId() const -> ClassId {
     return id_;
   }
@@ -129,8 +139,25 @@ class Class : public Object {
     return IsInstanceOf(T::GetClass());
   }
 
+  auto IsFinalized() const -> bool {
+    return allocation_size_ > 0;
+  }
+
+  auto GetAllocationSize() const -> uword {
+    return allocation_size_;
+  }
+
+  auto GetFieldOffsets() const -> const std::vector<uword>& {
+    return field_offsets_;
+  }
+
+  inline auto HasFieldOffsets() const -> bool {
+    return !field_offsets_.empty();
+  }
+
+  // lays out the instance fields after the `size` bytes of the native object & caches the resulting allocation size.
+  void Finalize(const uword size);
   auto NewInstance(const ObjectList& args) -> Object*;
-  auto GetAllocationSize() const -> uword;
   auto IsInstanceOf(Class* rhs) const -> bool;
   auto HasFunction(Symbol* symbol, const bool recursive = true) const -> bool;
   auto GetFunction(const std::string& name, const bool recursive = true) const -> Procedure*;
@@ -1,15 +1,51 @@
 #include "gel/collector.h"
 
+#include <condition_variable>
+#include <thread>
+
 #include "gel/common.h"
+#include "gel/compactor.h"
+#include "gel/event_loop.h"
+#include "gel/gc_stats.h"
 #include "gel/heap.h"
+#include "gel/heap_verifier.h"
+#include "gel/marker.h"
 #include "gel/module.h"
 #include "gel/object.h"
 #include "gel/platform.h"
 #include "gel/pointer.h"
 #include "gel/runtime.h"
+#include "gel/sweeper.h"
 #include "gel/zone.h"
 
 namespace gel {
+static std::vector<Object**> roots_{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void AddRoot(Object** slot) {
+  ASSERT(slot);
+  roots_.push_back(slot);
+}
+
+void RemoveRoot(Object** slot) {
+  ASSERT(slot);
+  // roots are mostly scoped, so the most recently added root is the most likely to be removed
+  const auto pos = std::find(std::rbegin(roots_), std::rend(roots_), slot);
+  ASSERT(pos != std::rend(roots_));
+  roots_.erase(std::next(pos).base());
+}
+
+static inline auto VisitGlobalRoots(const std::function<bool(Pointer**)>& vis) -> bool {
+  for (const auto& slot : roots_) {
+    if (!(*slot))
+      continue;
+    auto ptr = (*slot)->raw_ptr();
+    if (!vis(&ptr))
+      return false;
+    (*slot) = ptr->GetObjectPointer();
+  }
+  return true;
+}
+
 auto VisitRoots(PointerPointerVisitor* vis) -> bool {
   return VisitRoots([vis](Pointer** ptr) {
     return vis->Visit(ptr);
@@ -19,6 +55,10 @@ auto VisitRoots(PointerPointerVisitor* vis) -> bool {
 auto VisitRoots(const std::function<bool(Pointer**)>& vis) -> bool {
   if (!HasRuntime())
     return false;
+  if (!VisitGlobalRoots(vis)) {
+    LOG(ERROR) << "failed to visit global roots.";
+    return false;
+  }
   if (!Class::VisitClassPointers(vis)) {
     LOG(ERROR) << "failed to visit Class pointers.";
     return false;
@@ -27,136 +67,553 @@ auto VisitRoots(const std::function<bool(Pointer**)>& vis) -> bool {
     LOG(ERROR) << "failed to visit Module pointers.";
     return false;
   }
-  // TODO: should we visit the current local scope?
+  if (!NativeProcedure::VisitNativeProcedurePointers(vis)) {
+    LOG(ERROR) << "failed to visit NativeProcedure pointers.";
+    return false;
+  }
+  if (!GetRuntime()->VisitPointers(vis)) {
+    LOG(ERROR) << "failed to visit Runtime pointers.";
+    return false;
+  }
+#ifdef GEL_ENABLE_RX
+  if (!rx::GetRxScope()->VisitLocalPointers(vis)) {
+    LOG(ERROR) << "failed to visit rx pointers.";
+    return false;
+  }
+#endif  // GEL_ENABLE_RX
+  if (!EventLoop::VisitEventLoopPointers(vis)) {
+    LOG(ERROR) << "failed to visit EventLoop pointers.";
+    return false;
+  }
   return true;
 }
 
-Collector::Collector(Heap& heap) :
-  heap_(heap) {}
+DEFINE_uword(tenure_age, 2, "The number of minor collections a Pointer must survive before being promoted to the old zone.");
+DEFINE_uword(scavenger_threads, 0, "The number of threads evacuating the new zone during a minor collection, 0 for one per core.");
+
+auto GetNumberOfScavengerThreads() -> uword {
+  if (FLAGS_scavenger_threads > 0)
+    return FLAGS_scavenger_threads;
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+// a pool of detached threads shared by all minor collections, the calling thread always runs the first task.
+class ScavengerThreadPool {
+  DEFINE_NON_COPYABLE_TYPE(ScavengerThreadPool);
+
+ private:
+  std::mutex run_lock_{};  // serializes collections from different mutator threads
+  std::mutex lock_{};
+  std::condition_variable start_{};
+  std::condition_variable done_{};
+  std::function<void(const uword)> task_{};
+  uword generation_ = 0;
+  uword num_tasks_ = 0;
+  uword num_running_ = 0;
+  uword num_threads_ = 0;
+
+  // `generation` is the last run the thread has seen, so a thread started between runs doesn't pick up a stale task.
+  void RunThread(const uword idx, uword generation) {
+    while (true) {
+      std::function<void(const uword)> task;
+      {
+        std::unique_lock<std::mutex> lock(lock_);
+        start_.wait(lock, [&]() {
+          return generation_ != generation;
+        });
+        generation = generation_;
+        if (idx >= num_tasks_)
+          continue;
+        task = task_;
+      }
+      task(idx);
+      std::lock_guard<std::mutex> lock(lock_);
+      if (--num_running_ == 0)
+        done_.notify_all();
+    }
+  }
+
+  // starts the threads missing for `num_threads`, the pool outgrows its initial size when --scavenger_threads is raised.
+  void AddThreads(const uword num_threads) {
+    for (auto idx = num_threads_ + 1; idx <= num_threads; idx++) {
+      std::thread thread(&ScavengerThreadPool::RunThread, this, idx, generation_);
+      thread.detach();
+    }
+    num_threads_ = std::max(num_threads_, num_threads);
+  }
+
+ public:
+  explicit ScavengerThreadPool(const uword num_threads) {
+    AddThreads(num_threads);
+  }
+  ~ScavengerThreadPool() = default;
+
+  void Run(const uword num_tasks, const std::function<void(const uword)>& task) {
+    ASSERT(num_tasks >= 1);
+    std::lock_guard<std::mutex> run_lock(run_lock_);
+    AddThreads(num_tasks - 1);
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      task_ = task;
+      num_tasks_ = num_tasks;
+      num_running_ = num_tasks - 1;
+      generation_++;
+    }
+    start_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(lock_);
+    done_.wait(lock, [this]() {
+      return num_running_ == 0;
+    });
+    task_ = nullptr;
+  }
+
+  static inline auto Get() -> ScavengerThreadPool* {
+    // leaked on purpose, the detached threads outlive any static destructors
+    static const auto kPool = new ScavengerThreadPool(GetNumberOfScavengerThreads() - 1);
+    return kPool;
+  }
+};
+
+void ScavengerWorker::Push(Pointer* ptr) {
+  ASSERT(ptr);
+  std::lock_guard<std::mutex> lock(lock_);
+  work_.push_back(ptr);
+}
+
+auto ScavengerWorker::Pop() -> Pointer* {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (work_.empty())
+    return UNALLOCATED;
+  const auto next = work_.back();
+  work_.pop_back();
+  return next;
+}
+
+auto ScavengerWorker::Steal() -> Pointer* {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (work_.empty())
+    return UNALLOCATED;
+  const auto next = work_.front();
+  work_.pop_front();
+  return next;
+}
 
-auto Collector::CopyPointer(Pointer* ptr) -> Pointer* {
+auto ScavengerWorker::HasWork() -> bool {
+  std::lock_guard<std::mutex> lock(lock_);
+  return !work_.empty();
+}
+
+// copy buffers never leave a tail too small to hold the filler Pointer written when the buffer is retired.
+auto ScavengerWorker::TryAllocateCopy(const uword total_size) -> uword {
+  const auto remaining = GetNumberOfBytesRemaining();
+  if (remaining == total_size || remaining >= (total_size + sizeof(Pointer))) {
+    const auto address = current_;
+    current_ += total_size;
+    return address;
+  }
+
+  RetireCopyBuffer();
+  uword size = 0;
+  const auto address = collector()->TryAllocateCopyBuffer(total_size, &size);
+  if (address == UNALLOCATED)
+    return UNALLOCATED;
+  current_ = address + total_size;
+  end_ = address + size;
+  return address;
+}
+
+void ScavengerWorker::RetireCopyBuffer() {
+  const auto remaining = GetNumberOfBytesRemaining();
+  if (remaining > 0) {
+    ASSERT(remaining >= sizeof(Pointer));
+    Pointer::New(current_, Tag::Free(remaining - sizeof(Pointer)));
+  }
+  current_ = end_ = UNALLOCATED;
+}
+
+auto ScavengerWorker::CopyPointer(Pointer* ptr) -> Pointer* {
+  ASSERT(ptr);
+  const auto address = TryAllocateCopy(ptr->GetTotalSize());
+  if (address == UNALLOCATED)
+    return UNALLOCATED;
+  return Pointer::Copy(address, ptr);
+}
+
+auto ScavengerWorker::PromotePointer(Pointer* ptr) -> Pointer* {
   ASSERT(ptr);
-  const auto total_size = ptr->GetTotalSize();
-  if ((next_address() + total_size) >= (heap().new_zone().fromspace() + heap().new_zone().semisize()))
+  const auto address = collector()->TryPromote(ptr->GetObjectSize());
+  if (address == UNALLOCATED)
     return UNALLOCATED;
-  const auto next = Pointer::Copy(next_address(), ptr);
-  next_address_ += total_size;
+  const auto next = Pointer::At(address - sizeof(Pointer));
+  memcpy(next->GetObjectAddressPointer(), ptr->GetObjectAddressPointer(), ptr->GetObjectSize());
   return next;
 }
 
-auto Collector::Process(Pointer** ptr) -> bool {
-  ASSERT(ptr && (*ptr));
+// copies `ptr` before racing the other workers to install its forwarding address, the losers give their copy back.
+auto ScavengerWorker::Evacuate(Pointer* ptr) -> Pointer* {
+  ASSERT(ptr);
+  const auto age = ptr->GetTag().GetAge() + 1;
+  Pointer* next = UNALLOCATED;
+  bool promoted = false;
+  if (age >= GetTenureAge() && !collector()->promotion_failed_.load(std::memory_order_relaxed)) {
+    // once the OldZone can't satisfy a promotion, keep the remaining survivors in the NewZone for this cycle
+    next = PromotePointer(ptr);
+    promoted = (next != UNALLOCATED);
+    if (!promoted)
+      collector()->promotion_failed_.store(true, std::memory_order_relaxed);
+  }
+  if (!next) {
+    next = CopyPointer(ptr);
+    LOG_IF(FATAL, !next) << "failed to copy " << (*ptr) << " into: " << collector()->heap().GetNewZone();
+    next->tag().SetAge(age);
+  }
+
+  const auto forwarding = ptr->TryForward(next->GetStartingAddress());
+  if (forwarding != next->GetStartingAddress()) {
+    if (promoted) {
+      collector()->Unpromote(next);
+    } else {
+      // the copy is always the last allocation in this worker's copy buffer
+      ASSERT(next->GetEndingAddress() == current_);
+      current_ = next->GetStartingAddress();
+    }
+    return Pointer::At(forwarding);
+  }
+  if (promoted) {
+    bytes_promoted_ += next->GetTotalSize();
+  } else {
+    bytes_copied_ += next->GetTotalSize();
+  }
+  Push(next);
+  return next;
+}
+
+auto ScavengerWorker::Process(Pointer** ptr) -> bool {
+  ASSERT(ptr);
   const auto old_ptr = (*ptr);
-  const auto value = old_ptr->GetObjectPointer();
-  ASSERT(value);
-  DLOG(INFO) << "processing: " << (*old_ptr) << " := " << value->ToString();
-  const auto new_ptr = CopyPointer(old_ptr);
-  ASSERT(new_ptr);
-  new_ptr->tag().SetRememberedBit();
-  old_ptr->SetForwardingAddress(new_ptr->GetStartingAddress());
+  if (IsUnallocated(old_ptr))
+    return true;
+  if (collector()->IsEvacuating(old_ptr)) {
+    const auto forwarding = old_ptr->LoadForwardingAddress();
+    (*ptr) = forwarding != UNALLOCATED ? Pointer::At(forwarding) : Evacuate(old_ptr);
+  }
+  found_young_ |= collector()->IsNewPointer(*ptr);
   return true;
 }
 
-void Collector::ProcessRoots() {
-  const auto vis = [this](Pointer** ptr) {
-    return Process(ptr);
-  };
-  DLOG(INFO) << "processing roots....";
-  LOG_IF(FATAL, !VisitRoots(vis)) << "failed to visit roots.";
+auto ScavengerWorker::Scan(Pointer* ptr) -> bool {
+  ASSERT(ptr);
+  if (!ptr->GetTag().IsOld())
+    return ptr->VisitPointers(this);
+  found_young_ = false;
+  if (!ptr->VisitPointers(this))
+    return false;
+  if (found_young_)
+    collector()->Remember(ptr);
+  return true;
 }
 
-class PointerNotifier : public PointerPointerVisitor {
-  DEFINE_NON_COPYABLE_TYPE(PointerNotifier);
+// scans the local work list until it's empty, then steals from the other workers until every worker is idle.
+void ScavengerWorker::Drain() {
+  auto& num_active = collector()->num_active_;
+  while (true) {
+    Pointer* next = UNALLOCATED;
+    while ((next = Pop()) != UNALLOCATED)
+      LOG_IF(FATAL, !Scan(next)) << "failed to scan: " << (*next);
 
- public:
-  PointerNotifier() = default;
-  ~PointerNotifier() override = default;
-
-  auto Visit(Pointer** ptr) -> bool override {
-    ASSERT(ptr && (*ptr)->IsForwarding());
-    const auto old_ptr = (*ptr);
-    const auto new_ptr = (*ptr) = Pointer::At((*ptr)->GetForwardingAddress());
-    VLOG(1) << "forwarded " << (*old_ptr) << " => " << (*new_ptr);
-    return true;
+    num_active.fetch_sub(1, std::memory_order_acq_rel);
+    while (true) {
+      // workers only push onto their own list, so once every worker is idle no work is left anywhere
+      if (num_active.load(std::memory_order_acquire) == 0)
+        return;
+      num_active.fetch_add(1, std::memory_order_acq_rel);
+      next = collector()->TrySteal(this);
+      if (next)
+        break;
+      num_active.fetch_sub(1, std::memory_order_acq_rel);
+      std::this_thread::yield();
+    }
+    LOG_IF(FATAL, !Scan(next)) << "failed to scan: " << (*next);
   }
-};
+}
 
-void Collector::NotifyRoots() {
-  PointerNotifier notifier;
-  LOG_IF(FATAL, !VisitRoots(&notifier)) << "failed to notify roots.";
+auto ScavengerWorker::Visit(Pointer** ptr) -> bool {
+  ASSERT(ptr);
+  return Process(ptr);
 }
 
-auto Collector::Visit(Pointer** ptr) -> bool {
+Collector::Collector(Heap& heap, const uword num_workers) :
+  heap_(heap) {
+  ASSERT(num_workers >= 1);
+  for (auto idx = 0; idx < num_workers; idx++)
+    workers_.push_back(std::make_unique<ScavengerWorker>(this));
+}
+
+auto Collector::IsNewPointer(Pointer* ptr) const -> bool {
+  const auto& new_zone = heap().new_zone();
+  return ptr->GetStartingAddress() >= new_zone.GetStartingAddress() &&
+         ptr->GetStartingAddress() < new_zone.GetEndingAddress();
+}
+
+auto Collector::IsEvacuating(Pointer* ptr) const -> bool {
+  const auto& new_zone = heap().new_zone();
+  return ptr->GetStartingAddress() >= new_zone.tospace() &&
+         ptr->GetStartingAddress() < (new_zone.tospace() + new_zone.semisize());
+}
+
+auto Collector::IsAlive(Pointer** ptr) const -> bool {
   ASSERT(ptr && (*ptr));
-  if ((*ptr)->IsForwarding())
+  if (!IsEvacuating(*ptr))
     return true;
-  return Process(ptr);
+  const auto forwarding = (*ptr)->GetForwardingAddress();
+  if (forwarding == UNALLOCATED)
+    return false;
+  (*ptr) = Pointer::At(forwarding);
+  return true;
+}
+
+auto Collector::TryAllocateCopyBuffer(const uword min_size, uword* size) -> uword {
+  ASSERT(size);
+  const auto end = heap().new_zone().fromspace() + heap().new_zone().semisize();
+  auto address = next_address_.load(std::memory_order_relaxed);
+  do {
+    const auto remaining = end - address;
+    if (remaining < min_size)
+      return UNALLOCATED;
+    (*size) = std::min(std::max(kCopyBufferSize, min_size), remaining);
+    if (((*size) - min_size) < sizeof(Pointer))
+      (*size) = min_size;
+  } while (!next_address_.compare_exchange_weak(address, address + (*size), std::memory_order_relaxed));
+  return address;
+}
+
+auto Collector::TrySteal(ScavengerWorker* thief) -> Pointer* {
+  for (const auto& worker : workers_) {
+    if (worker.get() == thief)
+      continue;
+    const auto next = worker->Steal();
+    if (next)
+      return next;
+  }
+  return UNALLOCATED;
+}
+
+auto Collector::TryPromote(const uword size) -> uword {
+  std::lock_guard<std::mutex> lock(heap_lock_);
+  return heap().TryAllocateOldOrSweep(size);
+}
+
+void Collector::Unpromote(Pointer* ptr) {
+  ASSERT(ptr && ptr->GetTag().IsOld());
+  std::lock_guard<std::mutex> lock(heap_lock_);
+  heap().old_zone().free_list().Free(ptr->GetStartingAddress(), ptr->GetTotalSize());
 }
 
-auto Collector::ProcessFromspace() -> bool {
-  DLOG(INFO) << "processing fromspace....";
-  while (current_address() < next_address_) {
-    auto ptr = Pointer::At(current_address());
-    ASSERT(ptr);
-    DLOG(INFO) << "processing: " << (*ptr) << " ;; " << ptr->GetObjectPointer()->ToString();
-    if (!ptr->VisitPointers(this))
+void Collector::Remember(Pointer* ptr) {
+  std::lock_guard<std::mutex> lock(heap_lock_);
+  heap().Remember(ptr);
+}
+
+void Collector::ProcessRoots() {
+  const auto worker = GetWorker(0);
+  const auto vis = [worker](Pointer** ptr) {
+    return worker->Process(ptr);
+  };
+  DVLOG(1) << "processing roots....";
+  LOG_IF(FATAL, !VisitRoots(vis)) << "failed to visit roots.";
+}
+
+void Collector::ProcessRememberedSet() {
+  DVLOG(1) << "processing remembered set....";
+  const auto worker = GetWorker(0);
+  PointerList remembered;
+  std::swap(remembered, heap().remembered_);
+  for (const auto& ptr : remembered) {
+    ptr->tag().ClearRememberedBit();
+    LOG_IF(FATAL, !worker->Scan(ptr)) << "failed to process remembered pointer: " << (*ptr);
+  }
+
+  std::unordered_set<Pointer**> slots;
+  std::swap(slots, heap().remembered_slots_);
+  for (const auto& slot : slots) {
+    worker->found_young_ = false;
+    worker->Process(slot);
+    if (worker->found_young_)
+      heap().RememberSlot(slot);
+  }
+}
+
+// the value of an ephemeron is only evacuated once its key survived, which may in turn evacuate the key of another
+// ephemeron, so the live ephemerons are visited until they stop finding new survivors.
+void Collector::ProcessEphemerons() {
+  const auto worker = GetWorker(0);
+  const auto is_alive = [this](Pointer** ptr) {
+    return IsAlive(ptr);
+  };
+  while (true) {
+    for (auto& ptr : heap().weak_) {
+      if (IsAlive(&ptr))
+        LOG_IF(FATAL, !ptr->VisitEphemerons(is_alive, worker)) << "failed to visit ephemerons of: " << (*ptr);
+    }
+    if (!worker->HasWork())
+      return;
+    ProcessWorkLists();
+  }
+}
+
+// clears the weak references to Pointers that didn't survive, old Pointers are only cleared once swept.
+void Collector::ProcessWeakPointers() {
+  auto& weak = heap().weak_;
+  uword num_survivors = 0;
+  for (auto ptr : weak) {
+    if (!IsAlive(&ptr))
+      continue;
+    ptr->ClearWeakPointers([this](Pointer** referent) {
+      if (IsAlive(referent))
+        return true;
+      heap().num_weak_cleared_ += 1;
       return false;
-    curr_address_ += ptr->GetTotalSize();
+    });
+    weak[num_survivors++] = ptr;
   }
-  return true;
+  weak.resize(num_survivors);
+}
+
+// forwards the finalizable Pointers that survived & finalizes the rest, promoted Pointers are finalized once swept.
+void Collector::ProcessFinalizers() {
+  auto& finalizers = heap().new_finalizers_;
+  uword num_survivors = 0;
+  for (const auto& ptr : finalizers) {
+    if (!ptr->IsForwarding()) {
+      Heap::Finalize(ptr);
+      continue;
+    }
+    const auto next = Pointer::At(ptr->GetForwardingAddress());
+    if (next->GetTag().IsOld()) {
+      heap().old_finalizers_.push_back(next);
+      continue;
+    }
+    finalizers[num_survivors++] = next;
+  }
+  finalizers.resize(num_survivors);
+}
+
+void Collector::ProcessWorkLists() {
+  DVLOG(1) << "processing work lists w/ " << GetNumberOfWorkers() << " workers....";
+  num_active_.store(static_cast<word>(GetNumberOfWorkers()), std::memory_order_relaxed);
+  if (GetNumberOfWorkers() == 1)
+    return GetWorker(0)->Drain();
+  ScavengerThreadPool::Get()->Run(GetNumberOfWorkers(), [this](const uword idx) {
+    return GetWorker(idx)->Drain();
+  });
 }
 
 /*
- * Cheney's Algorithm:
- * collect() =
+ * Parallel Cheney's Algorithm:
  *  swap(fromspace, tospace)
- *  allocPtr = fromspace
- *  scanPtr = fromspace
- *  -- scan every root you've got
- *  ForEach root in the stack -- or elsewhere
- *   root = copy(root)
- *  EndForEach
- *  -- scan objects in the to-space (including objects added by this loop)
- *  While scanPtr < allocPtr
- *   ForEach reference r from o (pointed to by scanPtr)
- *    r = copy(r)
- *   EndForEach
- *   scanPtr = scanPtr + o.size() -- points to the next object in the to-space, if any
- *  EndWhile
+ *  -- evacuate the roots & the remembered set, gray copies are pushed onto worker 0's work list
+ *  -- every worker then scans its own work list, copying survivors into its own copy buffer & pushing the copies onto
+ *     its work list, idle workers steal gray copies from the other workers' lists
+ *  -- a fromspace object is forwarded by whichever worker installs its forwarding address first
+ *  -- the values of ephemerons w/ a surviving key are evacuated, then weak references to the dead are cleared
  */
 void Collector::Collect() {
+  heap().RetireAllocationBuffer();
+  const auto max_workers = std::max(heap().new_zone().GetNumberOfBytesAllocated() / kBytesPerScavengerThread,
+                                    static_cast<uword>(1));
+  if (GetNumberOfWorkers() > max_workers)
+    workers_.resize(max_workers);
   heap().new_zone().SwapSpaces();
-  next_address_ = curr_address_ = heap().new_zone().fromspace();
+  next_address_.store(heap().new_zone().fromspace(), std::memory_order_relaxed);
+  promotion_failed_.store(false, std::memory_order_relaxed);
   ProcessRoots();
-  LOG_IF(FATAL, !ProcessFromspace()) << "failed to process fromspace.";
-  NotifyRoots();
-  heap().new_zone().SetCurrent(next_address_);
+  ProcessRememberedSet();
+  ProcessWorkLists();
+  ProcessEphemerons();
+  ProcessWeakPointers();
+  for (const auto& worker : workers_)
+    worker->RetireCopyBuffer();
+  ProcessFinalizers();
+  heap().new_zone().SetCurrent(next_address());
+}
+
+auto Collector::GetNumberOfBytesCopied() const -> uword {
+  uword total = 0;
+  for (const auto& worker : workers_)
+    total += worker->bytes_copied_;
+  return total;
+}
+
+auto Collector::GetNumberOfBytesPromoted() const -> uword {
+  uword total = 0;
+  for (const auto& worker : workers_)
+    total += worker->bytes_promoted_;
+  return total;
 }
 
 void MinorCollection() {
   const auto heap = Heap::GetHeap();
   ASSERT(heap);
 
-  static const auto kPrintRoot = [](Pointer** ptr) {
-    ASSERT(ptr && (*ptr)->GetObjectPointer());
-    LOG(INFO) << "- " << (void*)(*ptr) << " ;; " << *(*ptr) << " " << (*ptr)->GetObjectPointer()->ToString();
-    return true;
-  };
-
-  LOG(INFO) << "NewZone before:";
-  PrintNewZone(heap->GetNewZone());
-  LOG(INFO) << "roots:";
-  LOG_IF(FATAL, !VisitRoots(kPrintRoot)) << "failed to visit roots.";
+  heap->RetireAllocationBuffer();
+  if (ShouldVerifyHeap())
+    VerifyHeap(*heap, "before minor collection");
+  const auto allocated = heap->GetNewZone().GetNumberOfBytesAllocated();
+  const auto start_ts = Clock::now();
+  // the scavenger rewrites the remembered slots & the fields of promoted Pointers w/ plain stores, so the marker thread
+  // mustn't be reading them meanwhile
+  const auto marking = heap->IsConcurrentMarking();
+  if (marking)
+    heap->PauseConcurrentMarking();
   Collector collector((*heap));
   collector.Collect();
+  if (marking)
+    heap->ResumeConcurrentMarking();
+  const auto pause = Clock::now() - start_ts;
+  if (ShouldVerifyHeap())
+    VerifyHeap(*heap, "after minor collection");
+  const auto survived = collector.GetNumberOfBytesCopied() + collector.GetNumberOfBytesPromoted();
+  heap->ResizeNewZone(allocated, survived, pause);
 
-  LOG(INFO) << "NewZone after:";
-  PrintNewZone(heap->GetNewZone());
-  LOG(INFO) << "roots:";
-  LOG_IF(FATAL, !VisitRoots(kPrintRoot)) << "failed to visit roots.";
+  GCEvent event(GCEvent::kMinorCollection, pause);
+  event.allocated = allocated;
+  event.copied = collector.GetNumberOfBytesCopied();
+  event.promoted = collector.GetNumberOfBytesPromoted();
+  event.freed = allocated - std::min(allocated, survived);
+  heap->RecordEvent(event);
+  if (heap->ShouldStartConcurrentMarking())
+    heap->StartConcurrentMarking();
 }
 
 void MajorCollection() {
-  NOT_IMPLEMENTED(FATAL);  // TODO: implement
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+
+  heap->RetireAllocationBuffer();
+  if (ShouldVerifyHeap())
+    VerifyHeap(*heap, "before major collection");
+  // the full collection needs every marked bit cleared, so the concurrent cycle in progress has to run to completion
+  if (heap->IsConcurrentMarking())
+    heap->FinishConcurrentMarking();
+  const auto start_ts = Clock::now();
+  heap->FinishSweeping();
+  Marker marker((*heap));
+  marker.MarkAll();
+  Sweeper sweeper((*heap));
+  sweeper.Sweep();
+  if (Compactor::ShouldCompact(heap->GetOldZone().free_list())) {
+    Compactor compactor((*heap));
+    compactor.Compact();
+  }
+  marker.ClearMarks();
+  heap->ResizeOldZone();
+  heap->ReleaseUnusedPages();
+  if (ShouldVerifyHeap())
+    VerifyHeap(*heap, "after major collection");
+
+  GCEvent event(GCEvent::kMajorCollection, Clock::now() - start_ts);
+  event.freed = sweeper.GetNumberOfBytesSwept();
+  heap->RecordEvent(event);
 }
 }  // namespace gel
\ No newline at end of file
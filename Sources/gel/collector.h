@@ -1,7 +1,14 @@
 #ifndef GEL_COLLECTOR_H
 #define GEL_COLLECTOR_H
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "gel/common.h"
+#include "gel/flags.h"
 #include "gel/platform.h"
 #include "gel/pointer.h"
 #include "gel/zone.h"
@@ -10,42 +17,192 @@ namespace gel {
 auto VisitRoots(PointerPointerVisitor* vis) -> bool;
 auto VisitRoots(const std::function<bool(Pointer**)>& vis) -> bool;
 
-class Collector : public PointerPointerVisitor {
+class Object;
+// registers a global Object* (e.g. a type's Class or a canonical value) as a root, keeping it alive & forwarded.
+void AddRoot(Object** slot);
+void RemoveRoot(Object** slot);
+
+template <class T>
+static inline void AddRoot(T** slot) {
+  return AddRoot((Object**)slot);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+template <class T>
+static inline void RemoveRoot(T** slot) {
+  return RemoveRoot((Object**)slot);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+// roots a native Object* (e.g. the target of an in-flight call) until the end of the enclosing C++ scope.
+template <class T>
+class ScopedRoot {
+  DEFINE_NON_COPYABLE_TYPE(ScopedRoot<T>);
+
+ private:
+  T** slot_;
+
+ public:
+  explicit ScopedRoot(T** slot) :
+    slot_(slot) {
+    ASSERT(slot_);
+    AddRoot(slot_);
+  }
+  ~ScopedRoot() {
+    RemoveRoot(slot_);
+  }
+};
+
+// a rooted, shared Object* slot for values captured by native callbacks (e.g. rx subscriptions & uv requests), the
+// slot is released once the last copy of the callback is destroyed.
+template <class T>
+class Persistent {
+ private:
+  std::shared_ptr<T*> slot_;
+
+  static inline void Release(T** slot) {
+    RemoveRoot(slot);
+    delete slot;
+  }
+
+ public:
+  Persistent(T* value = nullptr) :  // NOLINT(google-explicit-constructor)
+    slot_(new T*(value), &Release) {
+    AddRoot(slot_.get());
+  }
+  Persistent(const Persistent<T>& rhs) = default;
+  ~Persistent() = default;
+
+  auto Get() const -> T* {
+    return (*slot_);
+  }
+
+  operator T*() const {  // NOLINT(google-explicit-constructor)
+    return Get();
+  }
+
+  auto operator->() const -> T* {
+    return Get();
+  }
+
+  auto operator=(const Persistent<T>& rhs) -> Persistent<T>& = default;
+};
+
+DECLARE_uword(tenure_age);
+DECLARE_uword(scavenger_threads);
+
+static inline auto GetTenureAge() -> uword {
+  return FLAGS_tenure_age;
+}
+
+// the number of threads evacuating the NewZone during a minor collection, defaults to one per core.
+auto GetNumberOfScavengerThreads() -> uword;
+
+static constexpr const uword kCopyBufferSize = 16 * 1024;
+// the minimum number of bytes allocated in the NewZone per scavenger thread, smaller nurseries are evacuated by fewer
+// threads so short pauses don't pay for waking up the whole pool.
+static constexpr const uword kBytesPerScavengerThread = 256 * 1024;
+
+class Collector;
+// a thread evacuating the NewZone, survivors are copied into the worker's own copy buffer (PLAB) in the tospace &
+// pushed onto its work list, idle workers steal gray Pointers from the front of the other workers' lists.
+class ScavengerWorker : public PointerPointerVisitor {
+  friend class Collector;
+  DEFINE_NON_COPYABLE_TYPE(ScavengerWorker);
+
+ private:
+  Collector* collector_;
+  uword current_ = UNALLOCATED;
+  uword end_ = UNALLOCATED;
+  std::mutex lock_{};
+  std::deque<Pointer*> work_{};
+  bool found_young_ = false;
+  uword bytes_copied_ = 0;
+  uword bytes_promoted_ = 0;
+
+  inline auto collector() const -> Collector* {
+    return collector_;
+  }
+
+  inline auto GetNumberOfBytesRemaining() const -> uword {
+    return end_ - current_;
+  }
+
+  void Push(Pointer* ptr);
+  auto Pop() -> Pointer*;
+  auto Steal() -> Pointer*;
+  auto HasWork() -> bool;
+  auto TryAllocateCopy(const uword total_size) -> uword;
+  void RetireCopyBuffer();
+  auto CopyPointer(Pointer* ptr) -> Pointer*;
+  auto PromotePointer(Pointer* ptr) -> Pointer*;
+  auto Evacuate(Pointer* ptr) -> Pointer*;
+  auto Process(Pointer** ptr) -> bool;
+  auto Scan(Pointer* ptr) -> bool;
+  void Drain();
+
+ protected:
+  auto Visit(Pointer** ptr) -> bool override;
+
+ public:
+  explicit ScavengerWorker(Collector* collector) :
+    PointerPointerVisitor(),
+    collector_(collector) {}
+  ~ScavengerWorker() override = default;
+};
+
+class Collector {
+  friend class ScavengerWorker;
   DEFINE_NON_COPYABLE_TYPE(Collector);
 
  private:
   Heap& heap_;
-  uword curr_address_ = UNALLOCATED;
-  uword next_address_ = UNALLOCATED;
+  std::vector<std::unique_ptr<ScavengerWorker>> workers_{};
+  std::atomic<uword> next_address_{UNALLOCATED};  // the next address in the tospace to be handed out as a copy buffer
+  std::atomic<word> num_active_{0};               // the number of workers w/ gray Pointers left to scan
+  std::atomic<bool> promotion_failed_{false};
+  std::mutex heap_lock_{};  // guards the OldZone & the remembered set while promoting
 
   inline auto heap() const -> Heap& {
     return heap_;
   }
 
-  inline auto current_address() const -> uword {
-    return curr_address_;
+  inline auto next_address() const -> uword {
+    return next_address_.load(std::memory_order_relaxed);
   }
 
-  inline auto current_ptr() const -> Pointer* {
-    return Pointer::At(current_address());
+  inline auto GetNumberOfWorkers() const -> uword {
+    return workers_.size();
   }
 
-  inline auto next_address() const -> uword {
-    return next_address_;
+  inline auto GetWorker(const uword idx) const -> ScavengerWorker* {
+    ASSERT(idx >= 0 && idx < GetNumberOfWorkers());
+    return workers_[idx].get();
   }
 
- protected:
+  auto IsNewPointer(Pointer* ptr) const -> bool;
+  auto IsEvacuating(Pointer* ptr) const -> bool;
+  // true if `ptr` survived the collection, in which case `ptr` is updated to its forwarding address.
+  auto IsAlive(Pointer** ptr) const -> bool;
+  auto TryAllocateCopyBuffer(const uword min_size, uword* size) -> uword;
+  auto TrySteal(ScavengerWorker* thief) -> Pointer*;
+  auto TryPromote(const uword size) -> uword;
+  void Unpromote(Pointer* ptr);
+  void Remember(Pointer* ptr);
   void ProcessRoots();
-  auto ProcessFromspace() -> bool;
-  auto Process(Pointer** ptr) -> bool;
-  auto NotifyRoot(Pointer** ptr) -> bool;
-  auto CopyPointer(Pointer* ptr) -> Pointer*;
-  void NotifyRoots();
-  auto Visit(Pointer** ptr) -> bool override;
+  void ProcessRememberedSet();
+  void ProcessWorkLists();
+  void ProcessEphemerons();
+  void ProcessWeakPointers();
+  void ProcessFinalizers();
 
  public:
-  explicit Collector(Heap& heap);
-  ~Collector() override = default;
+  explicit Collector(Heap& heap, const uword num_workers = GetNumberOfScavengerThreads());
+  ~Collector() = default;
+
+  // the bytes evacuated into the tospace by the last collection.
+  auto GetNumberOfBytesCopied() const -> uword;
+  // the bytes evacuated into the OldZone by the last collection.
+  auto GetNumberOfBytesPromoted() const -> uword;
+
   void Collect();
 };
 
@@ -116,6 +116,16 @@ static inline auto IsPow2(T x) -> bool {
   return ((x & (x - 1)) == 0) && (x != 0);
 }
 
+static inline auto RoundUp(const uword x, const uword alignment) -> uword {
+  ASSERT(IsPow2(alignment));
+  return (x + (alignment - 1)) & ~(alignment - 1);
+}
+
+static inline auto RoundDown(const uword x, const uword alignment) -> uword {
+  ASSERT(IsPow2(alignment));
+  return x & ~(alignment - 1);
+}
+
 static inline void Split(const std::string& str, const char delimiter, std::vector<std::string>& results) {
   std::string current;
   current.reserve(str.size());
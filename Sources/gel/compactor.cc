@@ -0,0 +1,135 @@
+#include "gel/compactor.h"
+
+#include "gel/collector.h"
+#include "gel/free_list.h"
+#include "gel/heap.h"
+#include "gel/local_scope.h"
+#include "gel/zone.h"
+
+namespace gel {
+DEFINE_uword(compaction_threshold, 50,
+             "The fragmentation (%) of the old zone's free list that triggers a compaction during a major collection.");
+
+auto Compactor::GetFragmentation(const FreeList& free_list) -> uword {
+  static constexpr const uword kPercent = 100;
+  const auto num_free = free_list.GetNumberOfBytesFree();
+  if (num_free == 0)
+    return 0;
+  uword largest = 0;
+  free_list.VisitFreePointers([&largest](FreePointer* ptr) {
+    largest = std::max(largest, ptr->GetTotalSize());
+    return true;
+  });
+  return kPercent - ((largest * kPercent) / num_free);
+}
+
+auto Compactor::IsOldPointer(Pointer* ptr) const -> bool {
+  const auto& old_zone = heap().GetOldZone();
+  return ptr->GetStartingAddress() >= old_zone.GetStartingAddress() &&
+         ptr->GetStartingAddress() < old_zone.GetEndingAddress();
+}
+
+auto Compactor::Visit(Pointer** ptr) -> bool {
+  ASSERT(ptr);
+  const auto old_ptr = (*ptr);
+  if (IsUnallocated(old_ptr) || !IsOldPointer(old_ptr) || !old_ptr->IsForwarding())
+    return true;
+  (*ptr) = Pointer::At(old_ptr->GetForwardingAddress());
+  return true;
+}
+
+auto Compactor::ComputeForwardingAddresses() -> uword {
+  const auto& zone = heap().GetOldZone();
+  auto free_address = zone.GetStartingAddress();
+  auto current = zone.GetStartingAddress();
+  while (current < zone.GetEndingAddress()) {
+    const auto ptr = Pointer::At(current);
+    const auto total_size = ptr->GetTotalSize();
+    if (!ptr->GetTag().IsFree()) {
+      ptr->SetForwardingAddress(free_address);
+      free_address += total_size;
+    }
+    current += total_size;
+  }
+  return free_address;
+}
+
+void Compactor::UpdateReferences() {
+  // a forwarded slot already holds the new address, forwarding it again would read the forwarding address of whatever
+  // Pointer is there now. LocalVariables are the only slots reachable more than once, see LocalScope::VisitOnceScope.
+  LocalScope::VisitOnceScope visit_once;
+  LOG_IF(FATAL, !VisitRoots(this)) << "failed to update roots.";
+  // remembered slots are reachable from the roots or a live Pointer, visiting them again would forward them twice
+  for (auto& ptr : heap().remembered_)
+    Visit(&ptr);
+  for (auto& ptr : heap().old_finalizers_)
+    Visit(&ptr);
+  // weak references aren't visited by VisitPointers, the dead have been cleared by the Sweeper already
+  for (auto& ptr : heap().weak_) {
+    LOG_IF(FATAL, !ptr->VisitWeakPointers(this)) << "failed to update weak references in: " << (*ptr);
+    Visit(&ptr);
+  }
+  const auto& old_zone = heap().GetOldZone();
+  auto current = old_zone.GetStartingAddress();
+  while (current < old_zone.GetEndingAddress()) {
+    const auto ptr = Pointer::At(current);
+    if (!ptr->GetTag().IsFree())
+      LOG_IF(FATAL, !ptr->VisitPointers(this)) << "failed to update references in: " << (*ptr);
+    current += ptr->GetTotalSize();
+  }
+  // large objects are never moved, but they may still reference moved Pointers
+  LOG_IF(FATAL, !heap().GetLargeObjectSpace().VisitPointers([this](Pointer* ptr) {
+    return ptr->VisitPointers(this);
+  })) << "failed to update references in: "
+      << heap().GetLargeObjectSpace();
+  NewZone::Iterator iter(heap().GetNewZone());
+  while (iter.HasNext()) {
+    const auto ptr = iter.Next();
+    ASSERT(ptr);
+    if (ptr->GetTag().IsMarked())
+      LOG_IF(FATAL, !ptr->VisitPointers(this)) << "failed to update references in: " << (*ptr);
+  }
+}
+
+void Compactor::Relocate(const uword free_address) {
+  auto& zone = heap().old_zone();
+  uword last = UNALLOCATED;
+  auto current = zone.GetStartingAddress();
+  while (current < zone.GetEndingAddress()) {
+    const auto ptr = Pointer::At(current);
+    const auto total_size = ptr->GetTotalSize();
+    if (!ptr->GetTag().IsFree()) {
+      const auto dest = ptr->GetForwardingAddress();
+      ASSERT(dest <= current);
+      ptr->SetForwardingAddress(UNALLOCATED);
+      if (dest != current) {
+        memmove((void*)dest, (void*)current, total_size);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        num_moved_ += 1;
+        bytes_moved_ += total_size;
+      }
+      last = dest;
+    }
+    current += total_size;
+  }
+
+  auto& free_list = zone.free_list();
+  free_list.ClearBuckets();
+  const auto remaining = zone.GetEndingAddress() - free_address;
+  if (remaining >= FreeList::kMinimumChunkSize) {
+    free_list.Insert(FreePointer::New(free_address, Tag::Free(remaining - sizeof(Pointer))));
+  } else if (remaining > 0) {
+    // too small to hold a FreePointer, let the last Pointer absorb it so the zone stays walkable.
+    ASSERT(last != UNALLOCATED);
+    const auto ptr = Pointer::At(last);
+    ptr->tag().SetSize(ptr->GetObjectSize() + remaining);
+  }
+}
+
+void Compactor::Compact() {
+  const auto free_address = ComputeForwardingAddresses();
+  UpdateReferences();
+  Relocate(free_address);
+  DVLOG(1) << "compacted " << GetNumberOfPointersMoved() << " pointers ("
+           << units::data::byte_t(static_cast<double>(GetNumberOfBytesMoved())) << ") in: " << heap().GetOldZone();
+}
+}  // namespace gel
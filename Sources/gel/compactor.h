@@ -1,4 +1,63 @@
 #ifndef GEL_COMPACTOR_H
 #define GEL_COMPACTOR_H
 
+#include "gel/common.h"
+#include "gel/flags.h"
+#include "gel/pointer.h"
+
+namespace gel {
+DECLARE_uword(compaction_threshold);
+
+static inline auto GetCompactionThreshold() -> uword {
+  return FLAGS_compaction_threshold;
+}
+
+class Heap;
+class FreeList;
+class Compactor : public PointerPointerVisitor {
+  DEFINE_NON_COPYABLE_TYPE(Compactor);
+
+ private:
+  Heap& heap_;
+  uword num_moved_ = 0;
+  uword bytes_moved_ = 0;
+
+  inline auto heap() const -> Heap& {
+    return heap_;
+  }
+
+ protected:
+  auto IsOldPointer(Pointer* ptr) const -> bool;
+  auto ComputeForwardingAddresses() -> uword;
+  void UpdateReferences();
+  void Relocate(const uword free_address);
+
+ public:
+  explicit Compactor(Heap& heap) :
+    PointerPointerVisitor(),
+    heap_(heap) {}
+  ~Compactor() override = default;
+
+  auto GetNumberOfPointersMoved() const -> uword {
+    return num_moved_;
+  }
+
+  auto GetNumberOfBytesMoved() const -> uword {
+    return bytes_moved_;
+  }
+
+  auto Visit(Pointer** ptr) -> bool override;
+  // slides every live Pointer in the old zone down to the start of the zone (Lisp-2), leaving a single free chunk.
+  void Compact();
+
+ public:
+  // returns the fragmentation of the free list as a percentage, 0 meaning all free bytes are in a single chunk.
+  static auto GetFragmentation(const FreeList& free_list) -> uword;
+
+  static inline auto ShouldCompact(const FreeList& free_list) -> bool {
+    return GetFragmentation(free_list) >= GetCompactionThreshold();
+  }
+};
+}  // namespace gel
+
 #endif  // GEL_COMPACTOR_H
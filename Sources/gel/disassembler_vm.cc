@@ -44,7 +44,8 @@ auto Disassembler::Comment() -> std::ostream& {
 
 void Disassembler::Invoke(BytecodeDecoder& decoder, const Bytecode::Op op) {
   switch (op) {
-    case Bytecode::kInvoke: {
+    case Bytecode::kInvoke:
+    case Bytecode::kTailInvoke: {
       const auto lambda = decoder.NextObjectPointer();
       ASSERT(lambda && lambda->IsLambda());
       Comment(lambda) << ", num_args=" << decoder.NextUWord();
@@ -170,6 +171,7 @@ void Disassembler::Disassemble(const Region& region, const char* label) {
         break;
       }
       case Bytecode::kInvoke:
+      case Bytecode::kTailInvoke:
       case Bytecode::kInvokeNative:
       case Bytecode::kInvokeDynamic:
         Invoke(decoder, op.op());
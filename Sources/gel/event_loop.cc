@@ -2,52 +2,133 @@
 
 #include <uv.h>
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/error.h"
+#include "gel/heap.h"
 #include "gel/procedure.h"
 #include "gel/runtime.h"
 #include "gel/thread_local.h"
 #include "gel/to_string_helper.h"
+#include "gel/weak_ref.h"
 
 namespace gel {
 auto EventLoop::Run(const uv_run_mode mode) -> int {
-  return uv_run(Get(), mode);
+  const auto loop = Get();  // the EventLoop may move while the finalizers run
+  RunFinalizers();
+  return uv_run(loop, mode);
+}
+
+void EventLoop::InitCheck() {
+  ASSERT(check_);
+  {
+    const auto status = uv_check_init(Get(), check_);
+    LOG_IF(FATAL, status != 0) << "failed to initialize uv_check_t: " << uv_strerror(status);
+  }
+  {
+    const auto status = uv_check_start(check_, &OnCheck);
+    LOG_IF(FATAL, status != 0) << "failed to start uv_check_t: " << uv_strerror(status);
+  }
+  uv_unref((uv_handle_t*)check_);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+void EventLoop::OnCheck(uv_check_t* handle) {
+  ASSERT(handle);
+  return RunFinalizers();
 }
 
 auto EventLoop::CreateTimer(Procedure* on_tick) -> Timer* {
-  const auto timer = Timer::New(timers_.size() + 1, on_tick);
+  const auto timer = Timer::New(++next_timer_id_, on_tick);
   ASSERT(timer);
-  timers_.push_back(timer);
+  GetThreadEventLoop()->timers_.push_back(timer);  // allocating the Timer may have moved the loop
   return timer;
 }
 
 auto EventLoop::GetTimer(const uword idx) const -> Timer* {
-  const auto pos = std::find_if(std::begin(timers()), std::begin(timers()), [idx](Timer* timer) {
+  const auto pos = std::find_if(std::begin(timers()), std::end(timers()), [idx](Timer* timer) {
     return timer->GetId() == idx;
   });
   return pos != std::end(timers()) ? (*pos) : nullptr;
 }
 
-static inline auto WrapOnError(Procedure* on_error) -> OnErrorCallback {
+auto EventLoop::CloseTimer(const uword idx) -> bool {
+  const auto pos = std::find_if(std::begin(timers_), std::end(timers_), [idx](Timer* timer) {
+    return timer->GetId() == idx;
+  });
+  if (pos == std::end(timers_))
+    return false;
+  (*pos)->Stop();
+  PreWriteBarrier(*pos);
+  timers_.erase(pos);
+  return true;
+}
+
+void EventLoop::AddFinalizer(Object* target, Procedure* on_finalize) {
+  ASSERT(target);
+  ASSERT(on_finalize);
+  ScopedRoot<Procedure> root(&on_finalize);
+  const auto ref = WeakRef::New(target);
+  ASSERT(ref);
+  GetThreadEventLoop()->finalizers_.emplace_back(ref, on_finalize);  // allocating the WeakRef may have moved the loop
+}
+
+void EventLoop::RunFinalizers() {
+#ifndef GEL_DISABLE_HEAP
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  auto loop = GetThreadEventLoop();
+  if (loop->num_weak_cleared_ == heap->GetNumberOfWeakPointersCleared())
+    return;
+  loop->num_weak_cleared_ = heap->GetNumberOfWeakPointersCleared();
+  while (true) {
+    auto& finalizers = loop->finalizers_;
+    const auto pos = std::find_if(std::begin(finalizers), std::end(finalizers), [](const Finalizer& finalizer) {
+      return finalizer.first->IsCleared();
+    });
+    if (pos == std::end(finalizers))
+      return;
+    const auto on_finalize = pos->second;
+    PreWriteBarrier(pos->first);
+    PreWriteBarrier(on_finalize);
+    finalizers.erase(pos);
+    GetRuntime()->Call(on_finalize);
+    loop = GetThreadEventLoop();
+  }
+#endif  // GEL_DISABLE_HEAP
+}
+
+auto EventLoop::Execute(fs::RequestBase* request) -> bool {
+  ASSERT(request);
+  const auto status = request->Execute(this);
+  if (status != 0) {
+    DLOG(ERROR) << "failed to submit " << request->GetRequestName() << " for file " << request->GetPath() << ": "
+                << uv_strerror(status);
+    delete request;
+    return false;
+  }
+  return true;
+}
+
+static inline auto WrapOnError(const Persistent<Procedure>& on_error) -> OnErrorCallback {
   return [on_error](Error* error) {
     ASSERT(error);
     if (on_error)
-      return GetRuntime()->Call(on_error, {error});
+      return GetRuntime()->Call(on_error.Get(), {error});
   };
 }
 
-static inline auto WrapOnSuccess(Procedure* on_success) -> OnSuccessCallback {
+static inline auto WrapOnSuccess(const Persistent<Procedure>& on_success) -> OnSuccessCallback {
   return [on_success]() {
     if (on_success)
-      return GetRuntime()->Call(on_success);
+      return GetRuntime()->Call(on_success.Get());
   };
 }
 
-static inline auto WrapOnFinished(Procedure* on_finished) -> OnFinishedCallback {
+static inline auto WrapOnFinished(const Persistent<Procedure>& on_finished) -> OnFinishedCallback {
   return [on_finished]() {
     ASSERT(on_finished);
     if (on_finished)
-      return GetRuntime()->Call(on_finished);
+      return GetRuntime()->Call(on_finished.Get());
   };
 }
 
@@ -56,8 +137,8 @@ auto EventLoop::Stat(const std::string& path, Procedure* on_next, Procedure* on_
   ASSERT(on_next);
   return Stat(
       path,
-      [on_next](int stat) {
-        return GetRuntime()->Call(on_next, {Long::New(stat)});
+      [on_next = Persistent<Procedure>(on_next)](int stat) {
+        return GetRuntime()->Call(on_next.Get(), {Long::New(stat)});
       },
       WrapOnError(on_error), WrapOnFinished(on_finished));
 }
@@ -67,7 +148,7 @@ auto EventLoop::Stat(const std::string& path, const std::function<void(uword)>&
   ASSERT(!path.empty());
   const auto request = new fs::StatRequest(path, on_next, on_error, on_finished);
   ASSERT(request);
-  return request->Execute(this) == 0;
+  return Execute(request);
 }
 
 auto EventLoop::Rename(const std::string& old_path, const std::string& new_path, const OnSuccessCallback& on_success,
@@ -76,7 +157,7 @@ auto EventLoop::Rename(const std::string& old_path, const std::string& new_path,
   ASSERT(!new_path.empty());
   const auto request = new fs::RenameRequest(old_path, new_path, on_success, on_error, on_finished);
   ASSERT(request);
-  return request->Execute(this) == 0;
+  return Execute(request);
 }
 
 auto EventLoop::Rename(const std::string& old_path, const std::string& new_path, Procedure* on_success, Procedure* on_error,
@@ -91,7 +172,7 @@ auto EventLoop::Mkdir(const std::string& path, const int mode, const OnSuccessCa
   ASSERT(!path.empty());
   const auto request = new fs::MkdirRequest(path, mode, on_success, on_error, on_finished);
   ASSERT(request);
-  return request->Execute(this) == 0;
+  return Execute(request);
 }
 
 auto EventLoop::Mkdir(const std::string& path, const int mode, Procedure* on_success, Procedure* on_error, Procedure* on_finished)
@@ -105,7 +186,7 @@ auto EventLoop::Rmdir(const std::string& path, const OnSuccessCallback& on_succe
   ASSERT(!path.empty());
   const auto request = new fs::RmdirRequest(path, on_success, on_error, on_finished);
   ASSERT(request);
-  return request->Execute(this) == 0;
+  return Execute(request);
 }
 
 auto EventLoop::Rmdir(const std::string& path, Procedure* on_success, Procedure* on_error, Procedure* on_finished) -> bool {
@@ -118,7 +199,7 @@ auto EventLoop::Open(const std::string& path, const int flags, const int mode, c
   ASSERT(!path.empty());
   const auto request = new fs::OpenRequest(path, flags, mode, on_success, on_error, on_finished);
   ASSERT(request);
-  return request->Execute(this) == 0;
+  return Execute(request);
 }
 
 auto EventLoop::Open(const std::string& path, const int flags, const int mode, Procedure* on_success, Procedure* on_error,
@@ -156,6 +237,30 @@ auto EventLoop::New(const ObjectList& args) -> EventLoop* {
 
 static ThreadLocal<EventLoop> kEventLoop;
 
+auto EventLoop::VisitEventLoopPointers(const std::function<bool(Pointer**)>& vis) -> bool {
+  if (!kEventLoop)
+    return true;
+  EventLoop* loop = kEventLoop;
+  if (!VisitPointer(vis, &loop))
+    return false;
+  kEventLoop = loop;
+  loop->SetData(loop);
+  return true;
+}
+
+auto EventLoop::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  for (auto& timer : timers_) {
+    if (!VisitPointer(vis, &timer))
+      return false;
+  }
+  for (auto& [ref, on_finalize] : finalizers_) {
+    if (!VisitPointer(vis, &ref) || !VisitPointer(vis, &on_finalize))
+      return false;
+  }
+  return true;
+}
+
 void EventLoop::Init() {
   InitClass();
   Timer::InitClass();
@@ -170,6 +275,25 @@ auto GetThreadEventLoop() -> EventLoop* {
   return loop;
 }
 
+auto Timer::New(uword id, Procedure* on_tick) -> Timer* {
+  ASSERT(on_tick);
+  ScopedRoot<Procedure> root(&on_tick);  // allocating the Timer may move the callback
+  return new Timer(id, on_tick);
+}
+
+Timer::~Timer() {
+  uv_close((uv_handle_t*)handle_, &OnClose);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+void Timer::OnClose(uv_handle_t* handle) {
+  delete (uv_timer_t*)handle;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+auto Timer::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return VisitPointer(vis, &on_tick_);
+}
+
 auto Timer::ToString() const -> std::string {
   ToStringHelper<Timer> helper;
   helper.AddField("handle", (const void*)&handle());
@@ -199,8 +323,11 @@ auto Timer::New(const ObjectList& args) -> Timer* {
 }
 
 void Timer::OnTick(uv_timer_t* handle) {
-  const auto timer = ((Timer*)uv_handle_get_data((uv_handle_t*)handle));  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
-  ASSERT(timer);
+  // the handle only carries the id, the Timer itself may have moved since it was started
+  const auto id = (uword)uv_handle_get_data((uv_handle_t*)handle);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  const auto timer = GetThreadEventLoop()->GetTimer(id);
+  if (!timer)
+    return;
   const auto on_tick = timer->GetCallback();
   ASSERT(on_tick);
   const auto runtime = GetRuntime();
@@ -236,6 +363,7 @@ namespace fs {
     }                                                                                                                \
     uv_fs_req_cleanup(handle);                                                                                       \
     request->OnFinished();                                                                                           \
+    delete request;                                                                                                  \
   }
 
 FS_REQUEST_CALL_F(RenameRequest, uv_fs_rename, GetNewPath().c_str());
@@ -252,15 +380,17 @@ FS_REQUEST_CALLBACK_F(StatRequest) {
   ASSERT(handle);
   const auto request = From<StatRequest>(handle);
   ASSERT(request);
-  const auto result = request->handle()->result;
-  if (result == -1) {
+  const auto result = request->GetResult();
+  if (result < 0) {
     const auto message =
         fmt::format("error reading stats of file {}: {}", request->GetPath(), uv_strerror(static_cast<int>(result)));
-    return request->OnError(Error::New(message));
+    request->OnError(Error::New(message));
+  } else {
+    request->OnNext(request->handle()->statbuf.st_size);
   }
-  request->OnNext(request->handle()->statbuf.st_size);
   uv_fs_req_cleanup(handle);
   request->OnFinished();
+  delete request;
 }
 
 FS_REQUEST_CALL_F(OpenRequest, uv_fs_open, GetFlags(), GetMode());
@@ -17,31 +17,55 @@ using OnFinishedCallback = std::function<void()>;
 
 namespace fs {
 class Request;
+class RequestBase;
 using RequestCallback = std::function<void(Request*)>;
 }  // namespace fs
 
 class Timer;
 class EventLoop : public Object {
+ public:
+  using Finalizer = std::pair<WeakRef*, Procedure*>;
+
+ private:
+  static void OnCheck(uv_check_t* handle);
+
  private:
   uv_loop_t* loop_;
+  uv_check_t* check_;  // off-heap, runs the finalizers once per loop iteration
   std::vector<Timer*> timers_{};
+  uword next_timer_id_ = 0;
+  std::vector<Finalizer> finalizers_{};
+  uword num_weak_cleared_ = 0;  // the value of Heap::GetNumberOfWeakPointersCleared when the finalizers last ran
 
   explicit EventLoop(uv_loop_t* loop) :
     Object(),
-    loop_(loop) {
+    loop_(loop),
+    check_(new uv_check_t()) {
     ASSERT(loop_);
     SetData(this);
+    InitCheck();
   }
 
+  void InitCheck();
+  // submits `request`, which is deleted once its callback has finished or if it couldn't be submitted.
+  auto Execute(fs::RequestBase* request) -> bool;
+
   void SetData(void* data) {
     ASSERT(loop_);
     ASSERT(data);
     uv_loop_set_data(Get(), data);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~EventLoop() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto Get() const -> uv_loop_t* {
     return loop_;
   }
@@ -55,6 +79,10 @@ class EventLoop : public Object {
     return timers_;
   }
 
+  auto finalizers() const -> const std::vector<Finalizer>& {
+    return finalizers_;
+  }
+
   auto Stat(const std::string& path, const std::function<void(uword)>& on_next, const OnErrorCallback& on_error = {},
             const OnFinishedCallback& on_finished = {}) -> bool;
   auto Stat(const std::string& path, Procedure* on_next, Procedure* on_error, Procedure* on_finished) -> bool;
@@ -80,6 +108,10 @@ class EventLoop : public Object {
   auto GetTimer(const uword idx) const -> Timer*;
   auto Run(const uv_run_mode mode) -> int;
   auto CreateTimer(Procedure* on_tick) -> Timer*;
+  // stops the Timer & drops it from the loop, its handle is closed once the Timer is collected.
+  auto CloseTimer(const uword idx) -> bool;
+  // calls `on_finalize` from the loop once `target` has been collected.
+  void AddFinalizer(Object* target, Procedure* on_finalize);
 
   friend auto operator<<(std::ostream& stream, const EventLoop& rhs) -> std::ostream& {
     return stream << rhs.ToString();
@@ -89,6 +121,9 @@ class EventLoop : public Object {
 
  public:
   static void Init();
+  // calls the finalizers of the targets collected since the last call, the loop may move while they run.
+  static void RunFinalizers();
+  static auto VisitEventLoopPointers(const std::function<bool(Pointer**)>& vis) -> bool;
   static inline auto New(uv_loop_t* loop = uv_loop_new()) -> EventLoop* {
     ASSERT(loop);
     return new EventLoop(loop);
@@ -99,7 +134,7 @@ auto GetThreadEventLoop() -> EventLoop*;
 
 namespace fs {
 class RequestBase {
-  friend class EventLoop;
+  friend class gel::EventLoop;
   DEFINE_NON_COPYABLE_TYPE(RequestBase);
 
  private:
@@ -323,14 +358,18 @@ class Timer : public Object {
  private:
   static void OnTick(uv_timer_t* handle);
 
+ private:
+  static void OnClose(uv_handle_t* handle);
+
  private:
   uword id_;
-  uv_timer_t handle_{};
+  uv_timer_t* handle_;  // off-heap, uv keeps pointing at the handle while the Timer moves
   Procedure* on_tick_;
 
   Timer(uword id, Procedure* on_tick) :
     Object(),
     id_(id),
+    handle_(new uv_timer_t()),
     on_tick_(on_tick) {
     ASSERT(on_tick_);
     const auto loop = GetThreadEventLoop();
@@ -339,31 +378,34 @@ class Timer : public Object {
       const auto status = uv_timer_init(loop->Get(), handle());
       LOG_IF(FATAL, status != 0) << "failed to initialize uv_timer_t: " << uv_strerror(status);
     }
-    SetData(this);
+    SetData(id_);
+    RegisterFinalizer();
   }
 
-  void SetData(void* data) {
-    ASSERT(data);
-    uv_handle_set_data((uv_handle_t*)handle(), this);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  void SetData(const uword id) {
+    uv_handle_set_data((uv_handle_t*)handle(), (void*)id);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
   }
 
   void SetRepeat(const uword rhs) {
     uv_timer_set_repeat(handle(), rhs);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
-  ~Timer() override = default;
+  ~Timer() override;
 
   auto GetId() const -> uword {
     return id_;
   }
 
   auto handle() const -> const uv_timer_t& {
-    return handle_;
+    return (*handle_);
   }
 
   auto handle() -> uv_timer_t* {
-    return &handle_;
+    return handle_;
   }
 
   auto GetRepeat() const -> uword {
@@ -375,7 +417,7 @@ class Timer : public Object {
   }
 
   auto GetData() const -> void* {
-    return uv_handle_get_data((uv_handle_t*)this);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    return uv_handle_get_data((uv_handle_t*)&handle());  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
   }
 
   auto GetCallback() const -> Procedure* {
@@ -407,10 +449,7 @@ class Timer : public Object {
   DECLARE_TYPE(Timer);
 
  public:
-  static inline auto New(uword id, Procedure* on_tick) -> Timer* {
-    ASSERT(on_tick);
-    return new Timer(id, on_tick);
-  }
+  static auto New(uword id, Procedure* on_tick) -> Timer*;
 };
 }  // namespace gel
 
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <string>
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/heap.h"
 #include "gel/local.h"
@@ -21,6 +22,7 @@ void Expression::Init() {
   ASSERT(kClass == nullptr);
   kClass = Class::New(Object::GetClass(), kClassName);
   ASSERT(kClass);
+  AddRoot(&kClass);
 }
 
 #ifdef GEL_DISABLE_HEAP
@@ -34,9 +36,7 @@ void Expression::Init() {
 
 #define DEFINE_NEW_OPERATOR(Name)                     \
   auto Name::operator new(const size_t sz) -> void* { \
-    const auto heap = Heap::GetHeap();                \
-    ASSERT(heap);                                     \
-    const auto address = heap->TryAllocate(sz);       \
+    const auto address = Heap::Allocate(sz, #Name);   \
     ASSERT(address != UNALLOCATED);                   \
     return reinterpret_cast<void*>(address);          \
   }
@@ -540,4 +540,103 @@ auto LoadFieldExpr::ToString() const -> std::string {
   helper.AddField("field", GetField());
   return helper;
 }
+
+auto LiteralExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &value_);
+}
+
+auto QuotedExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &value_);
+}
+
+auto SequenceExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return Expression::VisitPointers(vis, children_);
+}
+
+auto CallProcExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &target_) && Expression::VisitPointers(vis, args_);
+}
+
+auto ClauseExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &key_) && Expression::VisitPointers(vis, actions_);
+}
+
+auto CondExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return Expression::VisitPointers(vis, clauses_) && VisitPointer(vis, &alt_);
+}
+
+auto WhenExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &test_) && Expression::VisitPointers(vis, actions_);
+}
+
+auto CaseExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &key_) && Expression::VisitPointers(vis, clauses_);
+}
+
+auto WhileExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return SequenceExpr::VisitPointers(vis) && VisitPointer(vis, &test_);
+}
+
+auto SetLocalExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &value_);
+}
+
+auto SetFieldExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &field_) && VisitPointer(vis, &instance_) && VisitPointer(vis, &value_);
+}
+
+auto Binding::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &value_);
+}
+
+auto LoadFieldExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return TemplateExpression<1>::VisitPointers(vis) && VisitPointer(vis, &field_);
+}
+
+auto ImportExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &module_);
+}
+
+auto RxOpExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  if (!SequenceExpr::VisitPointers(vis))
+    return false;
+  auto symbol = GetSymbol();
+  if (!VisitPointer(vis, &symbol))
+    return false;
+  if (symbol)
+    SetSymbol(symbol);
+  return true;
+}
+
+auto LetRxExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return SequenceExpr::VisitPointers(vis) && VisitPointer(vis, &source_);
+}
+
+auto LetExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return SequenceExpr::VisitPointers(vis) && Expression::VisitPointers(vis, bindings_);
+}
+
+auto InstanceOfExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return TemplateExpression<1>::VisitPointers(vis) && VisitPointer(vis, &target_);
+}
+
+auto CastExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return TemplateExpression<1>::VisitPointers(vis) && VisitPointer(vis, &target_);
+}
+
+auto NewExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &target_) && Expression::VisitPointers(vis, args_);
+}
+
+auto LoadInstanceMethodExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  return VisitPointer(vis, &class_) && VisitPointer(vis, &name_);
+}
+
+auto NewMapExpr::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  for (auto& [key, value] : data_) {
+    if (!VisitPointer(vis, &key) || !VisitPointer(vis, &value))
+      return false;
+  }
+  return true;
+}
 }  // namespace gel::expr
\ No newline at end of file
@@ -110,6 +110,15 @@ class Expression : public Object {  // TODO: should Expression inherit from Obje
     // do nothing
   }
 
+  template <class T>
+  static inline auto VisitPointers(PointerPointerVisitor* vis, std::vector<T*>& list) -> bool {
+    for (auto& value : list) {
+      if (!VisitPointer(vis, &value))
+        return false;
+    }
+    return true;
+  }
+
  public:
   ~Expression() override = default;
   virtual auto GetName() const -> const char* = 0;
@@ -159,6 +168,11 @@ class Expression : public Object {  // TODO: should Expression inherit from Obje
     return this;
   }
 
+  // the macro expander rewrites Expressions in place, so they're only visited while the mutator is stopped.
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto GetType() const -> Class* override {
     return GetClass();
   }
@@ -206,9 +220,19 @@ class TemplateExpression : public Expression {
   void SetChildAt(const uint64_t idx, Expression* value) override {
     ASSERT(idx >= 0 && idx <= NumInputs);
     ASSERT(value);
+    PreWriteBarrier(children_.at(idx));
     children_.at(idx) = value;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override {
+    ASSERT(vis);
+    for (auto& child : children_) {
+      if (!VisitPointer(vis, &child))
+        return false;
+    }
+    return true;
+  }
+
  public:
   auto GetNumberOfChildren() const -> uint64_t override {
     return NumInputs;
@@ -276,6 +300,8 @@ class LiteralExpr : public Expression {
     Expression(),
     value_(value) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~LiteralExpr() override = default;
 
@@ -557,6 +583,8 @@ class QuotedExpr : public Expression {
     ASSERT(value_);
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~QuotedExpr() override = default;
 
@@ -588,8 +616,11 @@ class SequenceExpr : public Expression {
  protected:
   SequenceExpr(const ExpressionList& children) {
     children_.insert(std::end(children_), std::begin(children), std::end(children));
+    RegisterFinalizer();
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~SequenceExpr() override = default;
 
@@ -613,6 +644,7 @@ class SequenceExpr : public Expression {
   void SetChildAt(const uint64_t idx, Expression* value) override {
     ASSERT(idx >= 0 && idx <= GetNumberOfChildren());
     ASSERT(value);
+    PreWriteBarrier(children_[idx]);
     children_[idx] = value;
   }
 
@@ -623,6 +655,7 @@ class SequenceExpr : public Expression {
 
   void RemoveChildAt(const uint64_t idx) override {
     ASSERT(idx >= 0 && idx <= GetNumberOfChildren());
+    PreWriteBarrier(children_[idx]);
     children_.erase(children_.begin() + static_cast<word>(idx));
   }
 
@@ -663,6 +696,7 @@ class CallProcExpr : public Expression {
     Expression(),
     args_(args) {
     SetTarget(target);
+    RegisterFinalizer();
   }
 
   inline void SetTarget(Expression* target) {
@@ -676,6 +710,8 @@ class CallProcExpr : public Expression {
     args_[idx] = expr;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~CallProcExpr() override = default;
 
@@ -739,8 +775,12 @@ class ClauseExpr : public Expression {  // TODO: should this be a WhenExpr?
     actions_(actions) {
     ASSERT(key_);
     ASSERT(!actions_.empty());
+    RegisterFinalizer();
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~ClauseExpr() override = default;
 
@@ -813,8 +853,11 @@ class CondExpr : public Expression {
     clauses_(clauses),
     alt_(alt) {
     ASSERT(!clauses_.empty());
+    RegisterFinalizer();
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~CondExpr() override = default;
 
@@ -893,6 +936,7 @@ class WhenExpr : public Expression {
     actions_(actions) {
     ASSERT(test_);
     ASSERT(!actions_.empty());
+    RegisterFinalizer();
   }
 
   void SetTest(Expression* test) {
@@ -910,6 +954,8 @@ class WhenExpr : public Expression {
     actions_[idx] = expr;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~WhenExpr() override = default;
 
@@ -964,7 +1010,12 @@ class CaseExpr : public Expression {
   explicit CaseExpr(Expression* key, const ClauseList& clauses) :  // NOLINT(modernize-pass-by-value)
     Expression(),
     key_(key),
-    clauses_(clauses) {}
+    clauses_(clauses) {
+    RegisterFinalizer();
+  }
+
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
  public:
   ~CaseExpr() override = default;
@@ -1010,6 +1061,8 @@ class WhileExpr : public SequenceExpr {
     SequenceExpr(body),
     test_(test) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~WhileExpr() override = default;
 
@@ -1045,6 +1098,8 @@ class SetLocalExpr : public Expression {
     value_ = rhs;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~SetLocalExpr() override = default;
 
@@ -1100,6 +1155,8 @@ class SetFieldExpr : public Expression {
     value_ = rhs;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~SetFieldExpr() override = default;
 
@@ -1151,6 +1208,8 @@ class Binding : public Expression {
     local_(local),
     value_(value) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~Binding() override = default;
 
@@ -1187,6 +1246,9 @@ class LoadFieldExpr : public TemplateExpression<1> {
     SetChildAt(0, expr);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~LoadFieldExpr() override = default;
 
@@ -1222,6 +1284,9 @@ class ImportExpr : public Expression {
     ASSERT(module_);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~ImportExpr() override = default;
 
@@ -1280,6 +1345,8 @@ class RxOpExpr : public SequenceExpr, public proto::HasSymbol {
     SequenceExpr(body),
     proto::HasSymbol(symbol) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~RxOpExpr() override = default;
 
@@ -1305,6 +1372,8 @@ class LetRxExpr : public TemplateLetExpr {
     TemplateLetExpr(scope, (const ExpressionList&)operators),  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
     source_(observable) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~LetRxExpr() override = default;
 
@@ -1350,6 +1419,8 @@ class LetExpr : public TemplateLetExpr {
     TemplateLetExpr(scope, body),
     bindings_(bindings) {}
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~LetExpr() override = default;
 
@@ -1436,6 +1507,8 @@ class InstanceOfExpr : public TemplateExpression<1> {
     SetChildAt(kValueIndex, rhs);
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~InstanceOfExpr() override = default;
 
@@ -1479,6 +1552,8 @@ class CastExpr : public TemplateExpression<1> {
     SetChildAt(kValueIndex, expr);
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~CastExpr() override = default;
 
@@ -1508,7 +1583,11 @@ class NewExpr : public Expression {
  protected:
   NewExpr(Class* target, const ExpressionList& args) :
     target_(target),
-    args_(args) {}
+    args_(args) {
+    RegisterFinalizer();
+  }
+
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
  public:
   ~NewExpr() override = default;
@@ -1560,6 +1639,9 @@ class LoadInstanceMethodExpr : Expression {
     ASSERT(name_);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~LoadInstanceMethodExpr() override = default;
 
@@ -1592,18 +1674,26 @@ class NewMapExpr : public Expression {
 
   explicit NewMapExpr(const EntryList& data) :
     Expression(),
-    data_(data) {}
+    data_(data) {
+    RegisterFinalizer();
+  }
 
   void RemoveChildAt(const uint64_t idx) override {
     ASSERT(idx >= 0 && idx <= GetNumberOfChildren());
+    PreWriteBarrier(data_[idx].first);
+    PreWriteBarrier(data_[idx].second);
     data_.erase(begin() + static_cast<EntryList::difference_type>(idx));
   }
 
   void SetChildAt(const uint64_t idx, Expression* value) override {
     ASSERT(idx >= 0 && idx <= GetNumberOfChildren());
+    PreWriteBarrier(data_[idx].second);
     data_[idx].second = value;
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~NewMapExpr() override = default;
 
@@ -1686,7 +1776,17 @@ class TemplateDefinition : public Definition {
   void SetChildAt(const uint64_t idx, Expression* value) override {
     ASSERT(idx >= 0 && idx <= NumInputs);
     ASSERT(value);
-    children_[idx] = value;  // NOLINT
+    PreWriteBarrier(children_[idx]);  // NOLINT
+    children_[idx] = value;           // NOLINT
+  }
+
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override {
+    ASSERT(vis);
+    for (auto& child : children_) {
+      if (!VisitPointer(vis, &child))
+        return false;
+    }
+    return true;
   }
 
  public:
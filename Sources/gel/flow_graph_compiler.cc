@@ -9,6 +9,7 @@
 #include "gel/disassembler.h"
 #include "gel/flow_graph_builder.h"
 #include "gel/instruction.h"
+#include "gel/lambda.h"
 #include "gel/local.h"
 #include "gel/local_scope.h"
 #include "gel/macro_expander.h"
@@ -69,6 +70,8 @@ auto FlowGraphCompiler::CompileTarget(E* exec, std::enable_if_t<gel::is_executab
   TIMER_STOP(total_ns);
   const auto code = assembler_.Assemble();
   exec->SetCodeRegion(code);
+  if constexpr (std::is_same_v<E, Lambda>)
+    exec->SetNumberOfLocals(std::max(GetNumberOfLocals(), exec->GetNumberOfArgs() + 1));
 #ifdef GEL_DEBUG
   DVLOG(10) << exec << " compiled in " << units::time::nanosecond_t(static_cast<double>(total_ns));
   exec->SetCompileTime(total_ns);
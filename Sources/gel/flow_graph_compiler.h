@@ -1,6 +1,7 @@
 #ifndef GEL_FLOW_GRAPH_COMPILER_H
 #define GEL_FLOW_GRAPH_COMPILER_H
 
+#include <algorithm>
 #include <type_traits>
 
 #include "gel/assembler.h"
@@ -35,6 +36,7 @@ class FlowGraphCompiler {
   LocalScope* scope_;
   Assembler assembler_{};
   std::vector<BlockInfo> info_{};
+  uword num_locals_ = 0;
 
   template <class E>  // TODO: use/create gel::is_compilable template predicate
   auto BuildFlowGraph(E* exec, std::enable_if_t<gel::is_executable<E>::value>* = nullptr) -> FlowGraph*;
@@ -56,6 +58,15 @@ class FlowGraphCompiler {
     return &assembler_;
   }
 
+  // the number of local slots used by the compiled code.
+  auto GetNumberOfLocals() const -> uword {
+    return num_locals_;
+  }
+
+  inline void UseLocal(const uword index) {
+    num_locals_ = std::max(num_locals_, index + 1);
+  }
+
   auto GetBlockInfo(const uword idx) -> BlockInfo& {
     if (idx > info_.size())
       info_.resize(idx + 1);
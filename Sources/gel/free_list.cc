@@ -22,19 +22,157 @@ auto FreePointer::Equals(FreePointer* rhs) const -> bool {
   return GetStartingAddress() == rhs->GetStartingAddress() && GetTotalSize() == rhs->GetTotalSize();  // TODO: check tag()
 }
 
-auto FreeList::VisitFreePointers(const std::function<bool(FreePointer*)>& vis) const -> bool {
-  auto current = head_;
+void FreeList::Insert(FreePointer* ptr) {
+  ASSERT(ptr);
+  ASSERT(ptr->tag().IsFree());
+  const auto size_class = GetSizeClass(ptr->GetTotalSize());
+  ptr->SetNext(GetBucket(size_class));
+  SetBucket(size_class, ptr);
+  num_free_ += ptr->GetTotalSize();
+}
+
+void FreeList::Remove(FreePointer* ptr) {
+  ASSERT(ptr);
+  const auto size_class = GetSizeClass(ptr->GetTotalSize());
+  FreePointer* previous = nullptr;
+  auto current = GetBucket(size_class);
+  while (current != nullptr && current != ptr) {
+    previous = current;
+    current = current->GetNext();
+  }
+  LOG_IF(FATAL, current == nullptr) << "failed to find " << (*ptr) << " in: " << (*this);
+  if (previous)
+    previous->SetNext(ptr->GetNext());
+  else
+    SetBucket(size_class, ptr->GetNext());
+  ptr->SetNext(nullptr);
+  num_free_ -= ptr->GetTotalSize();
+}
+
+auto FreeList::FindFirstFit(const word size_class, const uword total_size) -> FreePointer* {
+  FreePointer* previous = nullptr;
+  auto current = GetBucket(size_class);
   while (current != nullptr) {
-    if (!vis(current))
-      return false;
+    if (current->GetTotalSize() >= total_size) {
+      if (previous)
+        previous->SetNext(current->GetNext());
+      else
+        SetBucket(size_class, current->GetNext());
+      current->SetNext(nullptr);
+      num_free_ -= current->GetTotalSize();
+      return current;
+    }
+    previous = current;
     current = current->GetNext();
   }
+  return nullptr;
+}
+
+auto FreeList::CoalesceForward(uword address, uword total_size) -> uword {
+  while ((address + total_size) < GetEndingAddress()) {
+    const auto next = FreePointer::At(address + total_size);
+    if (!next->tag().IsFree())
+      break;
+    Remove(next);
+    total_size += next->GetTotalSize();
+  }
+  return total_size;
+}
+
+void FreeList::Reset() {
+  ClearBuckets();
+  if (!IsAllocated())
+    return;
+  ASSERT(GetSize() >= kMinimumChunkSize);
+  Insert(FreePointer::New(GetStartingAddress(), Tag::Free(GetSize() - sizeof(Pointer))));
+}
+
+void FreeList::Free(const uword address, const uword total_size) {
+  ASSERT(address >= GetStartingAddress() && (address + total_size) <= GetEndingAddress());
+  ASSERT(total_size >= kMinimumChunkSize);
+  const auto chunk_size = CoalesceForward(address, total_size);
+  Insert(FreePointer::New(address, Tag::Free(chunk_size - sizeof(Pointer))));
+}
+
+void FreeList::Grow(const uword size) {
+  ASSERT(size >= kMinimumChunkSize);
+  const auto address = GetEndingAddress();
+  SetSize(GetSize() + size);
+  Free(address, size);
+}
+
+void FreeList::Coalesce() {
+  ClearBuckets();
+  auto current = GetStartingAddress();
+  while (current < GetEndingAddress()) {
+    const auto chunk = FreePointer::At(current);
+    auto total_size = chunk->GetTotalSize();
+    if (chunk->tag().IsFree()) {
+      while ((current + total_size) < GetEndingAddress()) {
+        const auto next = FreePointer::At(current + total_size);
+        if (!next->tag().IsFree())
+          break;
+        total_size += next->GetTotalSize();
+      }
+      Insert(FreePointer::New(current, Tag::Free(total_size - sizeof(Pointer))));
+    }
+    current += total_size;
+  }
+}
+
+auto FreeList::GetNumberOfFreePointers() const -> uword {
+  uword count = 0;
+  VisitFreePointers([&count](FreePointer* ptr) {
+    count += 1;
+    return true;
+  });
+  return count;
+}
+
+auto FreeList::VisitFreePointers(const std::function<bool(FreePointer*)>& vis) const -> bool {
+  for (const auto& bucket : buckets_) {
+    auto current = bucket;
+    while (current != nullptr) {
+      if (!vis(current))
+        return false;
+      current = current->GetNext();
+    }
+  }
   return true;
 }
 
-auto FreeList::TryAllocate(const uword size) -> uword {
+auto FreeList::TryAllocate(const uword size, const bool coalesce) -> uword {
   ASSERT(size > UNALLOCATED);
-  NOT_IMPLEMENTED(ERROR);  // TODO: implement
-  return UNALLOCATED;
+  const auto total_size = RoundUpChunkSize(sizeof(Pointer) + size);
+  const auto size_class = GetSizeClass(total_size);
+  const auto find_chunk = [&]() -> FreePointer* {
+    for (auto idx = size_class; idx < kNumberOfSizeClasses; idx++) {
+      const auto chunk = FindFirstFit(idx, total_size);
+      if (chunk)
+        return chunk;
+    }
+    return nullptr;
+  };
+
+  auto chunk = find_chunk();
+  if (!chunk) {
+    if (!coalesce)
+      return UNALLOCATED;
+    Coalesce();
+    if (!(chunk = find_chunk()))
+      return UNALLOCATED;
+  }
+  ASSERT(chunk);
+
+  const auto address = chunk->GetStartingAddress();
+  auto chunk_size = chunk->GetTotalSize();
+  if ((chunk_size - total_size) >= kMinimumChunkSize) {
+    Insert(FreePointer::New(address + total_size, Tag::Free(chunk_size - total_size - sizeof(Pointer))));
+    chunk_size = total_size;
+  }
+  memset((void*)address, 0, chunk_size);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  const auto ptr = Pointer::New(address, Tag::Old(chunk_size - sizeof(Pointer)));
+  ASSERT(ptr);
+  return ptr->GetObjectAddress();
 }
-}  // namespace gel
\ No newline at end of file
+}  // namespace gel
@@ -1,6 +1,9 @@
 #ifndef GEL_FREE_LIST_H
 #define GEL_FREE_LIST_H
 
+#include <array>
+#include <functional>
+
 #include "gel/common.h"
 #include "gel/platform.h"
 #include "gel/pointer.h"
@@ -9,6 +12,8 @@
 namespace gel {
 class FreePointer {
   friend class FreeList;
+  friend class Sweeper;
+  friend class Compactor;
   DEFINE_NON_COPYABLE_TYPE(FreePointer);
 
  private:
@@ -84,33 +89,96 @@ class FreePointer {
 
 class FreeList : public Region {
   friend class OldZone;
+  friend class Sweeper;
+  friend class Compactor;
+  friend class HeapVerifier;
   DEFINE_DEFAULT_COPYABLE_TYPE(FreeList);
 
+ public:
+  static constexpr const uword kMinimumChunkSize = sizeof(FreePointer);
+  static constexpr const uword kMinimumChunkSizeLog2 = 4;
+  static constexpr const word kNumberOfSizeClasses = 16;
+  static_assert(kMinimumChunkSize == (1 << kMinimumChunkSizeLog2));
+  static_assert(sizeof(FreePointer) == sizeof(Pointer));
+
+  // chunks are binned by the power of two of their total size, the last class holds every chunk >= 512kb.
+  static inline auto GetSizeClass(const uword total_size) -> word {
+    ASSERT(total_size >= kMinimumChunkSize);
+    word size_class = -static_cast<word>(kMinimumChunkSizeLog2);
+    auto remaining = total_size;
+    while (remaining > 1) {
+      remaining >>= 1;
+      size_class += 1;
+    }
+    return std::min(size_class, kNumberOfSizeClasses - 1);
+  }
+
+  static inline auto RoundUpChunkSize(const uword size) -> uword {
+    return (size + (kWordSize - 1)) & ~(kWordSize - 1);
+  }
+
  private:
-  FreePointer* head_;
+  std::array<FreePointer*, kNumberOfSizeClasses> buckets_{};
+  uword num_free_ = 0;
+
+  void Insert(FreePointer* ptr);
+  void Remove(FreePointer* ptr);
+  auto FindFirstFit(const word size_class, const uword total_size) -> FreePointer*;
+  auto CoalesceForward(uword address, uword total_size) -> uword;
+
+  inline auto GetBucket(const word size_class) const -> FreePointer* {
+    ASSERT(size_class >= 0 && size_class < kNumberOfSizeClasses);
+    return buckets_[size_class];  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+  }
+
+  inline void SetBucket(const word size_class, FreePointer* ptr) {
+    ASSERT(size_class >= 0 && size_class < kNumberOfSizeClasses);
+    buckets_[size_class] = ptr;  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+  }
+
+  void ClearBuckets() {
+    buckets_.fill(nullptr);
+    num_free_ = 0;
+  }
 
  protected:
   FreeList() :
-    Region(),
-    head_(nullptr) {}
+    Region() {}
   FreeList(const uword start_address, const uword size) :
-    Region(start_address, size),
-    head_(FreePointer::New(start_address, Tag::Old(size))) {
-    ASSERT(head_);
+    Region(start_address, size) {
+    Reset();
   }
 
  public:
   ~FreeList() override = default;
 
-  auto TryAllocate(const uword size) -> uword;
+  auto GetNumberOfBytesFree() const -> uword {
+    return num_free_;
+  }
+
+  auto GetNumberOfBytesAllocated() const -> uword {
+    return GetSize() - GetNumberOfBytesFree();
+  }
+
+  auto GetNumberOfFreePointers() const -> uword;
+
+  // returns the whole region to a single free chunk.
+  void Reset();
+  // returns the chunk [address, address + total_size) to the free list, merging it w/ any free chunks directly after it.
+  void Free(const uword address, const uword total_size);
+  // extends the region by `size` bytes & returns them to the free list as a single chunk.
+  void Grow(const uword size);
+  // walks the region in address order, merges neighbouring free chunks & rebuilds the size classes.
+  void Coalesce();
+  // coalesces the whole region when no chunk fits unless `coalesce` is false (e.g. while the region is swept lazily).
+  auto TryAllocate(const uword size, const bool coalesce = true) -> uword;
   auto VisitFreePointers(const std::function<bool(FreePointer*)>& vis) const -> bool;
 
   friend auto operator<<(std::ostream& stream, const FreeList& rhs) -> std::ostream& {
     stream << "FreeList(";
     stream << "starting_address=" << rhs.GetStartingAddressPointer() << ", ";
     stream << "total_size=" << units::data::byte_t(static_cast<double>(rhs.GetSize())) << ", ";
-    if (rhs.head_)
-      stream << "head=" << rhs.head_->ToString();
+    stream << "free=" << units::data::byte_t(static_cast<double>(rhs.GetNumberOfBytesFree()));
     stream << ")";
     return stream;
   }
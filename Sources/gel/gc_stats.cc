@@ -0,0 +1,123 @@
+#include "gel/gc_stats.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace gel {
+DEFINE_bool(dump_gc_stats, false, "Dump the gc statistics as JSON to the reports directory at exit.");
+
+void PauseHistogram::Record(const Clock::duration& pause) {
+  const auto us = static_cast<uword>(std::chrono::duration_cast<std::chrono::microseconds>(pause).count());
+  const auto idx = std::min(static_cast<uword>(std::bit_width(us)), kNumberOfBuckets - 1);
+  buckets_[idx] += 1;
+  count_ += 1;
+  total_ += pause;
+  max_ = std::max(max_, pause);
+}
+
+auto PauseHistogram::GetPercentile(const uword percentile) const -> Clock::duration {
+  ASSERT(percentile >= 0 && percentile <= 100);
+  if (count_ == 0)
+    return {};
+  const auto rank = std::max(static_cast<uword>(1), (count_ * percentile + 99) / 100);
+  uword seen = 0;
+  for (uword idx = 0; idx < kNumberOfBuckets; idx++) {
+    seen += buckets_[idx];
+    if (seen >= rank)
+      return std::min(GetBucketLimit(idx), max_);
+  }
+  return max_;
+}
+
+auto GCStats::GetTotalPause() const -> Clock::duration {
+  Clock::duration total{};
+  for (const auto& pauses : pauses_)
+    total += pauses.GetTotalPause();
+  return total;
+}
+
+auto GCStats::GetAllocationRate() const -> uword {
+  const auto mutator = std::chrono::duration_cast<std::chrono::microseconds>(GetMutatorTime()).count();
+  if (mutator <= 0)
+    return 0;
+  return (GetNumberOfBytesAllocated() * 1000000) / static_cast<uword>(mutator);
+}
+
+auto GCStats::GetSurvivalRate() const -> uword {
+  if (bytes_scavenged_ == 0)
+    return 0;
+  return ((bytes_copied_ + bytes_promoted_) * 100) / bytes_scavenged_;
+}
+
+void GCStats::Record(GCEvent& event) {
+  ASSERT(event.kind >= 0 && event.kind < GCEvent::kNumberOfKinds);
+  event.timestamp = Clock::now() - start_;
+  pauses_[event.kind].Record(event.pause);
+  if (event.kind == GCEvent::kMinorCollection) {
+    // the survivors of the previous minor collection were already counted when they were allocated
+    bytes_allocated_ += event.allocated - std::min(event.allocated, survivors_);
+    bytes_scavenged_ += event.allocated;
+    survivors_ = event.copied;
+  }
+  bytes_copied_ += event.copied;
+  bytes_promoted_ += event.promoted;
+  bytes_freed_ += event.freed;
+  if (events_.size() >= kMaxNumberOfEvents)
+    events_.pop_front();
+  events_.push_back(event);
+}
+
+static inline auto ToMicroseconds(const Clock::duration& duration) -> uword {
+  return static_cast<uword>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void GCStats::ToJson(std::ostream& stream) const {
+  const auto uptime = GetUptime();
+  stream << "{";
+  stream << "\"uptime_us\":" << ToMicroseconds(uptime) << ",";
+  stream << "\"mutator_us\":" << ToMicroseconds(uptime - GetTotalPause()) << ",";
+  stream << "\"bytes_allocated\":" << GetNumberOfBytesAllocated() << ",";
+  stream << "\"bytes_copied\":" << GetNumberOfBytesCopied() << ",";
+  stream << "\"bytes_promoted\":" << GetNumberOfBytesPromoted() << ",";
+  stream << "\"bytes_freed\":" << GetNumberOfBytesFreed() << ",";
+  stream << "\"allocation_rate\":" << GetAllocationRate() << ",";
+  stream << "\"survival_rate\":" << GetSurvivalRate() << ",";
+  stream << "\"pauses\":{";
+  for (auto kind = 0; kind < GCEvent::kNumberOfKinds; kind++) {
+    const auto& pauses = GetPauses(static_cast<GCEvent::Kind>(kind));
+    if (kind > 0)
+      stream << ",";
+    stream << "\"" << static_cast<GCEvent::Kind>(kind) << "\":{";
+    stream << "\"count\":" << pauses.GetNumberOfPauses() << ",";
+    stream << "\"total_us\":" << ToMicroseconds(pauses.GetTotalPause()) << ",";
+    stream << "\"mean_us\":" << ToMicroseconds(pauses.GetMeanPause()) << ",";
+    stream << "\"max_us\":" << ToMicroseconds(pauses.GetMaxPause()) << ",";
+    stream << "\"p50_us\":" << ToMicroseconds(pauses.GetPercentile(50)) << ",";
+    stream << "\"p99_us\":" << ToMicroseconds(pauses.GetPercentile(99)) << ",";
+    stream << "\"histogram\":[";
+    for (uword idx = 0; idx < PauseHistogram::kNumberOfBuckets; idx++)
+      stream << (idx > 0 ? "," : "") << pauses.GetBucket(idx);
+    stream << "]}";
+  }
+  stream << "},";
+  stream << "\"events\":[";
+  auto first = true;
+  for (const auto& event : GetEvents()) {
+    if (!first)
+      stream << ",";
+    first = false;
+    stream << "{";
+    stream << "\"kind\":\"" << event.kind << "\",";
+    stream << "\"timestamp_us\":" << ToMicroseconds(event.timestamp) << ",";
+    stream << "\"pause_us\":" << ToMicroseconds(event.pause) << ",";
+    stream << "\"allocated\":" << event.allocated << ",";
+    stream << "\"copied\":" << event.copied << ",";
+    stream << "\"promoted\":" << event.promoted << ",";
+    stream << "\"freed\":" << event.freed << ",";
+    stream << "\"used\":" << event.used << ",";
+    stream << "\"size\":" << event.size;
+    stream << "}";
+  }
+  stream << "]}";
+}
+}  // namespace gel
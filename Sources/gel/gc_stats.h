@@ -0,0 +1,196 @@
+#ifndef GEL_GC_STATS_H
+#define GEL_GC_STATS_H
+
+#include <units.h>
+
+#include <array>
+#include <deque>
+#include <ostream>
+
+#include "gel/common.h"
+#include "gel/flags.h"
+
+namespace gel {
+DECLARE_bool(dump_gc_stats);
+
+static inline auto ShouldDumpGCStats() -> bool {
+  return FLAGS_dump_gc_stats;
+}
+
+// a log2 histogram of gc pauses, bucket `i` counts the pauses shorter than 2^i microseconds.
+class PauseHistogram {
+  DEFINE_DEFAULT_COPYABLE_TYPE(PauseHistogram);
+
+ public:
+  static constexpr const uword kNumberOfBuckets = 24;
+
+ private:
+  std::array<uword, kNumberOfBuckets> buckets_{};
+  uword count_ = 0;
+  Clock::duration total_{};
+  Clock::duration max_{};
+
+ public:
+  PauseHistogram() = default;
+  ~PauseHistogram() = default;
+
+  auto GetNumberOfPauses() const -> uword {
+    return count_;
+  }
+
+  auto GetTotalPause() const -> Clock::duration {
+    return total_;
+  }
+
+  auto GetMaxPause() const -> Clock::duration {
+    return max_;
+  }
+
+  auto GetMeanPause() const -> Clock::duration {
+    if (count_ == 0)
+      return {};
+    return total_ / static_cast<Clock::rep>(count_);
+  }
+
+  auto GetBucket(const uword idx) const -> uword {
+    ASSERT(idx >= 0 && idx < kNumberOfBuckets);
+    return buckets_[idx];
+  }
+
+  void Record(const Clock::duration& pause);
+  // an upper bound of the `percentile`th pause, the limit of the bucket it falls in.
+  auto GetPercentile(const uword percentile) const -> Clock::duration;
+
+  static inline auto GetBucketLimit(const uword idx) -> Clock::duration {
+    return std::chrono::microseconds(static_cast<uword>(1) << idx);
+  }
+};
+
+// a single gc pause, the sizes are in bytes.
+struct GCEvent {
+  DEFINE_DEFAULT_COPYABLE_TYPE(GCEvent);
+
+ public:
+  enum Kind {
+    kMinorCollection = 0,
+    kMajorCollection,
+    kInitialMark,
+    kRemark,
+    kNumberOfKinds,
+  };
+
+  Kind kind = kMinorCollection;
+  Clock::duration timestamp{};  // the end of the pause, relative to the start of the heap
+  Clock::duration pause{};
+  uword allocated = 0;  // the bytes in the new zone at the start of a minor collection
+  uword copied = 0;     // the bytes copied within the new zone
+  uword promoted = 0;   // the bytes copied from the new zone into the old zone
+  uword freed = 0;
+  uword used = 0;  // the bytes allocated in the heap after the pause
+  uword size = 0;  // the size of the heap after the pause
+
+  GCEvent() = default;
+  GCEvent(const Kind k, const Clock::duration& p) :
+    kind(k),
+    pause(p) {}
+  ~GCEvent() = default;
+
+  friend auto operator<<(std::ostream& stream, const Kind& rhs) -> std::ostream& {
+    switch (rhs) {
+      case kMinorCollection:
+        return stream << "minor";
+      case kMajorCollection:
+        return stream << "major";
+      case kInitialMark:
+        return stream << "initial-mark";
+      case kRemark:
+        return stream << "remark";
+      default:
+        return stream << "unknown";
+    }
+  }
+
+  friend auto operator<<(std::ostream& stream, const GCEvent& rhs) -> std::ostream& {
+    using namespace units::data;
+    stream << "GCEvent(";
+    stream << "kind=" << rhs.kind << ", ";
+    stream << "pause=" << units::time::nanosecond_t(static_cast<double>(rhs.pause.count())) << ", ";
+    stream << "copied=" << byte_t(static_cast<double>(rhs.copied)) << ", ";
+    stream << "promoted=" << byte_t(static_cast<double>(rhs.promoted)) << ", ";
+    stream << "freed=" << byte_t(static_cast<double>(rhs.freed)) << ", ";
+    stream << "used=" << byte_t(static_cast<double>(rhs.used)) << "/" << byte_t(static_cast<double>(rhs.size));
+    stream << ")";
+    return stream;
+  }
+};
+
+// the running totals & the most recent events of a Heap's collections.
+class GCStats {
+  DEFINE_NON_COPYABLE_TYPE(GCStats);
+
+ public:
+  static constexpr const uword kMaxNumberOfEvents = 1024;
+
+ private:
+  Clock::time_point start_;
+  std::array<PauseHistogram, GCEvent::kNumberOfKinds> pauses_{};
+  std::deque<GCEvent> events_{};  // oldest first
+  uword survivors_ = 0;           // the bytes left in the new zone by the last minor collection
+  uword bytes_allocated_ = 0;
+  uword bytes_copied_ = 0;
+  uword bytes_promoted_ = 0;
+  uword bytes_freed_ = 0;
+  uword bytes_scavenged_ = 0;  // the bytes allocated in the new zone that a minor collection ran over
+
+ public:
+  GCStats() :
+    start_(Clock::now()) {}
+  ~GCStats() = default;
+
+  auto GetUptime() const -> Clock::duration {
+    return Clock::now() - start_;
+  }
+
+  auto GetPauses(const GCEvent::Kind kind) const -> const PauseHistogram& {
+    ASSERT(kind >= 0 && kind < GCEvent::kNumberOfKinds);
+    return pauses_[kind];
+  }
+
+  auto GetEvents() const -> const std::deque<GCEvent>& {
+    return events_;
+  }
+
+  auto GetTotalPause() const -> Clock::duration;
+
+  auto GetMutatorTime() const -> Clock::duration {
+    return GetUptime() - GetTotalPause();
+  }
+
+  // the bytes allocated in the new zone since the heap started, counted at each minor collection.
+  auto GetNumberOfBytesAllocated() const -> uword {
+    return bytes_allocated_;
+  }
+
+  auto GetNumberOfBytesCopied() const -> uword {
+    return bytes_copied_;
+  }
+
+  auto GetNumberOfBytesPromoted() const -> uword {
+    return bytes_promoted_;
+  }
+
+  auto GetNumberOfBytesFreed() const -> uword {
+    return bytes_freed_;
+  }
+
+  // the bytes allocated in the new zone per second of mutator time.
+  auto GetAllocationRate() const -> uword;
+  // the percentage of the new zone that survived its minor collections.
+  auto GetSurvivalRate() const -> uword;
+
+  void Record(GCEvent& event);
+  void ToJson(std::ostream& stream) const;
+};
+}  // namespace gel
+
+#endif  // GEL_GC_STATS_H
@@ -1,55 +1,327 @@
 #include "gel/heap.h"
 
+#include <cstdlib>
+#include <fstream>
+
+#include "gel/allocation_profiler.h"
 #include "gel/collector.h"
 #include "gel/common.h"
+#include "gel/heap_verifier.h"
+#include "gel/immortal_space.h"
+#include "gel/marker.h"
+#include "gel/object.h"
 #include "gel/os_thread.h"
 #include "gel/platform.h"
 #include "gel/section.h"
+#include "gel/sweeper.h"
 #include "gel/thread_local.h"
 #include "gel/zone.h"
 
 namespace gel {
+DEFINE_uword(tlab_size, 32 * 1024, "The size of the blocks bump allocated from the new zone by each thread.");
+DEFINE_uword(target_pause_ms, 10, "The minor collection pause (in ms) the new zone is allowed to grow towards.");
+
 Heap::Heap() :
   new_zone_(),
-  old_zone_() {}
+  old_zone_(),
+  large_object_space_() {
+  if (IsAllocationProfilerEnabled())
+    profiler_ = std::make_unique<AllocationProfiler>();
+}
+
+auto Heap::TryAllocateOldOrSweep(const uword size) -> uword {
+  // the unswept pages still hold free chunks that aren't in the FreeList, so it mustn't coalesce them
+  auto result = old_zone_.free_list().TryAllocate(size, !IsSweeping());
+  while (result == UNALLOCATED && IsSweeping()) {
+    sweeper_->SweepPage();
+    result = old_zone_.free_list().TryAllocate(size, !IsSweeping());
+  }
+  if (result != UNALLOCATED && IsConcurrentMarking())
+    Pointer::At(result - sizeof(Pointer))->tag().SetMarkedBit();
+  return result;
+}
 
 auto Heap::TryAllocateOld(const uword size) -> uword {
   using namespace units::data;
+  if (IsConcurrentMarking() && marker_->IsIdle())
+    FinishConcurrentMarking();
   uword result = UNALLOCATED;
-  if ((result = old_zone_.TryAllocate(size)) == UNALLOCATED) {
-    LOG(ERROR) << "failed to allocate large object of " << byte_t(static_cast<double>(size));
-    gel::MajorCollection();
+  if ((result = TryAllocateOldOrSweep(size)) != UNALLOCATED)
+    return result;
+  if (IsConcurrentMarking()) {
+    // end the cycle early, sweeping might free enough space w/o a full collection
+    FinishConcurrentMarking();
+    if ((result = TryAllocateOldOrSweep(size)) != UNALLOCATED)
+      return result;
+  }
+  DVLOG(1) << "failed to allocate old object of " << byte_t(static_cast<double>(size));
+  gel::MajorCollection();
+  if ((result = old_zone_.TryAllocate(size)) == UNALLOCATED && old_zone_.TryGrow(size)) {
+    DVLOG(1) << "grew old zone to: " << old_zone_;
     result = old_zone_.TryAllocate(size);
-    LOG_IF(FATAL, IsUnallocated(result)) << "failed to allocate large object of " << byte_t(static_cast<double>(size));
   }
-  ASSERT(result != UNALLOCATED);
+  LOG_IF(FATAL, IsUnallocated(result)) << "failed to allocate old object of " << byte_t(static_cast<double>(size));
   return result;
 }
 
+void Heap::RetireAllocationBuffer() {
+  if (IsProfilingAllocations())
+    profiler_->Consume(tlab_.GetCurrentAddress() - tlab_.counted_);
+  if (tlab_.GetEndingAddress() == new_zone_.GetCurrentAddress())
+    new_zone_.SetCurrent(tlab_.GetCurrentAddress());
+  tlab_.Reset();
+}
+
+auto Heap::RefillAllocationBuffer(const uword size) -> bool {
+  RetireAllocationBuffer();
+  const auto required = sizeof(Pointer) + size;
+  const auto remaining = (new_zone_.fromspace() + new_zone_.semisize()) - new_zone_.GetCurrentAddress();
+  if (remaining <= required)
+    return false;
+  const auto block_size = std::min(std::max(GetLocalAllocationBufferSize(), required), remaining);
+  const auto start = new_zone_.TryAllocateBlock(block_size);
+  if (start == UNALLOCATED)
+    return false;
+  tlab_.Reset(start, start + block_size);
+  return true;
+}
+
 auto Heap::TryAllocateNew(const uword size) -> uword {
   using namespace units::data;
   uword result = UNALLOCATED;
-  if ((result = new_zone_.TryAllocate(size)) == UNALLOCATED) {
-    LOG(ERROR) << "failed to allocate new object of " << byte_t(static_cast<double>(size));
+  if ((result = tlab_.TryAllocateUnsampled(size)) != UNALLOCATED)
+    return result;
+  // refilling the LocalAllocationBuffer is the mutator's safepoint for finishing a concurrent marking cycle
+  if (IsConcurrentMarking() && marker_->IsIdle())
+    FinishConcurrentMarking();
+  if (!RefillAllocationBuffer(size)) {
+    DVLOG(1) << "failed to allocate new object of " << byte_t(static_cast<double>(size));
     gel::MinorCollection();
-    result = new_zone_.TryAllocate(size);
-    LOG_IF(FATAL, IsUnallocated(result)) << "failed to allocate new object of " << byte_t(static_cast<double>(size));
+    if (!RefillAllocationBuffer(size)) {
+      // the survivors fill the new zone, grow it or tenure the object right away.
+      if (!new_zone_.TryGrow() || !RefillAllocationBuffer(size))
+        return TryAllocateOld(size);
+      DVLOG(1) << "grew new zone to: " << new_zone_;
+    }
   }
+  result = tlab_.TryAllocateUnsampled(size);
   ASSERT(result != UNALLOCATED);
   return result;
 }
 
-auto Heap::TryAllocate(const uword size) -> uword {
-  ASSERT(size > 0);
+auto Heap::TryAllocateLarge(const uword size) -> uword {
+  using namespace units::data;
+  if (IsConcurrentMarking() && marker_->IsIdle())
+    FinishConcurrentMarking();
+  // large objects don't fill either zone, so the LargeObjectSpace triggers a collection of its own
+  if (large_object_space_.ShouldCollect() && !IsConcurrentMarking()) {
+    DVLOG(1) << "large object space exceeded its limit: " << large_object_space_;
+    if (GetConcurrentMarkThreshold() > 0) {
+      StartConcurrentMarking();
+    } else {
+      gel::MajorCollection();
+    }
+  }
   uword result = UNALLOCATED;
-  if (size >= kLargeObjectSize)
-    return TryAllocateOld(size);
-  return TryAllocateNew(size);
+  if ((result = large_object_space_.TryAllocate(size)) == UNALLOCATED) {
+    DVLOG(1) << "failed to allocate large object of " << byte_t(static_cast<double>(size));
+    gel::MajorCollection();
+    result = large_object_space_.TryAllocate(size);
+  }
+  LOG_IF(FATAL, IsUnallocated(result)) << "failed to allocate large object of " << byte_t(static_cast<double>(size));
+  if (IsConcurrentMarking())
+    Pointer::At(result - sizeof(Pointer))->tag().SetMarkedBit();
+  return result;
+}
+
+auto Heap::TryAllocate(const uword size, const char* type) -> uword {
+  ASSERT(size > 0);
+  const auto result = size >= kLargeObjectSize ? TryAllocateLarge(size) : TryAllocateNew(size);
+  if (IsProfilingAllocations())
+    SampleAllocation(result, size, type);
+  return result;
+}
+
+void Heap::SampleAllocation(const uword address, const uword size, const char* type) {
+  const auto total_size = sizeof(Pointer) + size;
+  auto allocated = tlab_.GetCurrentAddress() - tlab_.counted_;
+  // large objects & objects tenured right away aren't allocated from the LocalAllocationBuffer
+  if (address <= tlab_.counted_ || address > tlab_.GetCurrentAddress())
+    allocated += total_size;
+  if (profiler_->Consume(allocated))
+    profiler_->Sample(type, total_size);
+  tlab_.counted_ = tlab_.GetCurrentAddress();
+  tlab_.limit_ = std::min(tlab_.GetEndingAddress(), tlab_.GetCurrentAddress() + profiler_->GetBytesUntilSample());
+}
+
+void Heap::ResizeNewZone(const uword allocated, const uword survived, const Clock::duration& pause) {
+  if (allocated == 0 || pause >= GetTargetPause())
+    return;
+  const auto survival_rate = (survived * 100) / allocated;
+  if (survival_rate > kMaxNewZoneGrowthSurvivalRate)
+    return;
+  if (new_zone_.TryGrow())
+    DVLOG(1) << "grew new zone to: " << new_zone_ << " (survival rate: " << survival_rate << "%)";
+}
+
+void Heap::ResizeOldZone() {
+  const auto occupancy = (old_zone_.GetNumberOfBytesAllocated() * 100) / old_zone_.GetSize();
+  if (occupancy < kMaxOldZoneOccupancy)
+    return;
+  if (old_zone_.TryGrow(old_zone_.GetSize()))
+    DVLOG(1) << "grew old zone to: " << old_zone_ << " (occupancy: " << occupancy << "%)";
+}
+
+void Heap::ReleaseUnusedPages() {
+  old_zone_.ReleaseFreePages();
+  new_zone_.ReleaseTospace();
+}
+
+void Heap::Remember(Pointer* ptr) {
+  ASSERT(ptr && ptr->GetTag().IsOld());
+  if (ptr->GetTag().IsRemembered())
+    return;
+  ptr->tag().SetRememberedBit();
+  remembered_.push_back(ptr);
+}
+
+void Heap::RememberSlot(Pointer** slot) {
+  ASSERT(slot);
+  remembered_slots_.insert(slot);
+}
+
+void Heap::RememberOverwritten(Pointer* ptr) {
+  ASSERT(IsConcurrentMarking());
+  marker_->Log(ptr);
+}
+
+void Heap::RegisterFinalizer(Pointer* ptr) {
+  ASSERT(ptr);
+  if (ptr->GetTag().IsNew()) {
+    new_finalizers_.push_back(ptr);
+  } else {
+    old_finalizers_.push_back(ptr);
+  }
+}
+
+void Heap::RegisterWeakPointers(Pointer* ptr) {
+  ASSERT(ptr);
+  weak_.push_back(ptr);
+}
+
+void Heap::Finalize(Pointer* ptr) {
+  ASSERT(ptr);
+  DVLOG(100) << "finalizing: " << (*ptr);
+  ptr->GetObjectPointer()->~Object();
+}
+
+auto Heap::IsSweeping() const -> bool {
+  return sweeper_ && !sweeper_->IsFinished();
+}
+
+auto Heap::ShouldStartConcurrentMarking() const -> bool {
+  if (GetConcurrentMarkThreshold() == 0 || IsConcurrentMarking() || IsSweeping())
+    return false;
+  const auto occupancy = (old_zone_.GetNumberOfBytesAllocated() * 100) / old_zone_.GetSize();
+  return occupancy >= GetConcurrentMarkThreshold();
+}
+
+void Heap::StartConcurrentMarking() {
+  ASSERT(!IsConcurrentMarking());
+  const auto start_ts = Clock::now();
+  FinishSweeping();
+  marker_ = std::make_unique<ConcurrentMarker>(*this);
+  marking_ = true;
+  marker_->Start();
+  GCEvent event(GCEvent::kInitialMark, Clock::now() - start_ts);
+  RecordEvent(event);
+}
+
+void Heap::FinishConcurrentMarking() {
+  ASSERT(IsConcurrentMarking());
+  const auto start_ts = Clock::now();
+  marker_->Finish();
+  marker_.reset();
+  marking_ = false;
+  sweeper_ = std::make_unique<Sweeper>(*this);
+  sweeper_->Start();
+  if (ShouldVerifyHeap())
+    VerifyHeap(*this, "after remark");
+  // the old zone is swept lazily, only the large objects have been freed by the end of the pause
+  GCEvent event(GCEvent::kRemark, Clock::now() - start_ts);
+  event.freed = sweeper_->GetNumberOfBytesSwept();
+  RecordEvent(event);
+}
+
+void Heap::PauseConcurrentMarking() {
+  ASSERT(IsConcurrentMarking());
+  marker_->Pause();
+}
+
+void Heap::ResumeConcurrentMarking() {
+  ASSERT(IsConcurrentMarking());
+  marker_->Resume();
+}
+
+void Heap::RecordEvent(GCEvent& event) {
+  event.used = GetNumberOfBytesAllocated();
+  event.size = GetTotalSize();
+  stats_.Record(event);
+  DVLOG(1) << event;
+}
+
+void Heap::FinishSweeping() {
+  if (!sweeper_)
+    return;
+  sweeper_->Finish();
+  sweeper_.reset();
 }
 
 void Heap::Clear() {
+  marker_.reset();
+  marking_ = false;
+  sweeper_.reset();
+  tlab_.Reset();
   new_zone_.Clear();
   old_zone_.Clear();
+  large_object_space_.Clear();
+  remembered_.clear();
+  remembered_slots_.clear();
+  new_finalizers_.clear();
+  old_finalizers_.clear();
+  weak_.clear();
+}
+
+void RememberPointer(Pointer* ptr) {
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  heap->Remember(ptr);
+}
+
+void RememberSlot(Pointer** slot) {
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  heap->RememberSlot(slot);
+}
+
+void RememberOverwritten(Pointer* ptr) {
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  heap->RememberOverwritten(ptr);
+}
+
+void RegisterFinalizer(Pointer* ptr) {
+  if (IsImmortal(ptr))
+    return;  // never collected, so never finalized
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  heap->RegisterFinalizer(ptr);
+}
+
+void RegisterWeakPointers(Pointer* ptr) {
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  heap->RegisterWeakPointers(ptr);
 }
 
 static const ThreadLocal<Heap> heap_{};
@@ -59,10 +331,36 @@ auto Heap::GetHeap() -> Heap* {
   return heap_.Get();
 }
 
+static void DumpGCStats() {
+  const auto heap = Heap::GetHeap();
+  if (!heap)
+    return;
+  const auto filename = GetReportFilename("gc_stats.json");
+  std::ofstream stream(filename);
+  LOG_IF(ERROR, !stream) << "failed to open: " << filename;
+  heap->GetStats().ToJson(stream);
+  DVLOG(1) << "dumped gc stats to: " << filename;
+}
+
+static void DumpAllocationProfile() {
+  const auto heap = Heap::GetHeap();
+  if (!heap || !heap->IsProfilingAllocations())
+    return;
+  const auto filename = GetReportFilename("allocations.folded");
+  std::ofstream stream(filename);
+  LOG_IF(ERROR, !stream) << "failed to open: " << filename;
+  heap->GetAllocationProfiler()->ToCollapsedStacks(stream);
+  DVLOG(1) << "dumped " << heap->GetAllocationProfiler()->GetNumberOfSamples() << " allocation samples to: " << filename;
+}
+
 void Heap::Init() {
   ASSERT(heap_.IsEmpty());
   heap_.Set(new Heap());
   ASSERT(heap_);
+  if (ShouldDumpGCStats())
+    std::atexit(&DumpGCStats);
+  if (IsAllocationProfilerEnabled())
+    std::atexit(&DumpAllocationProfile);
 #ifdef GEL_DEBUG
   DVLOG(100) << "heap initialized.";
   if (VLOG_IS_ON(100)) {
@@ -81,6 +379,7 @@ void PrintHeap(Heap& heap) {
   DLOG(INFO) << "  Total Size: " << byte_t(static_cast<double>(heap.GetTotalSize()));
   PrintNewZone(heap.GetNewZone());
   PrintOldZone(heap.GetOldZone());
+  DLOG(INFO) << "  " << heap.GetLargeObjectSpace();
 }
 
 #endif  // GEL_DEBUG
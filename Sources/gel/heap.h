@@ -3,23 +3,127 @@
 
 #include <units.h>
 
+#include <memory>
+#include <unordered_set>
+
 #include "gel/common.h"
+#include "gel/flags.h"
+#include "gel/gc_stats.h"
+#include "gel/large_object_space.h"
+#include "gel/pointer.h"
 #include "gel/section.h"
 #include "gel/zone.h"
 
 namespace gel {
 static constexpr const auto kLargeObjectSize = 4 * 1024;
+
+DECLARE_uword(tlab_size);
+DECLARE_uword(target_pause_ms);
+
+static inline auto GetTargetPause() -> Clock::duration {
+  return std::chrono::milliseconds(FLAGS_target_pause_ms);
+}
+
+static inline auto GetLocalAllocationBufferSize() -> uword {
+  return FLAGS_tlab_size;
+}
+
+// a thread-local block of the NewZone that objects are bump allocated from w/o going through the Heap, the block is
+// refilled by the Heap once exhausted & retired (handing the unused tail back to the NewZone) before a collection.
+// while profiling allocations the fast path stops at the next sample, so the Heap's slow path can take it.
+class LocalAllocationBuffer {
+  friend class Heap;
+  DEFINE_NON_COPYABLE_TYPE(LocalAllocationBuffer);
+
+ private:
+  uword current_ = UNALLOCATED;
+  uword end_ = UNALLOCATED;
+  uword limit_ = UNALLOCATED;    // end_, or the address of the next allocation sample if it's before end_
+  uword counted_ = UNALLOCATED;  // the bytes before this address were counted towards the next allocation sample
+
+  inline void Reset(const uword start = UNALLOCATED, const uword end = UNALLOCATED) {
+    current_ = start;
+    end_ = end;
+    limit_ = end;
+    counted_ = start;
+  }
+
+  inline auto TryAllocate(const uword size, const uword limit) -> uword {
+    const auto total_size = sizeof(Pointer) + size;
+    if ((limit - current_) < total_size)
+      return UNALLOCATED;
+    const auto address = current_;
+    current_ += total_size;
+    return Pointer::New(address, size)->GetObjectAddress();
+  }
+
+  // allocates past the next allocation sample.
+  inline auto TryAllocateUnsampled(const uword size) -> uword {
+    return TryAllocate(size, end_);
+  }
+
+ public:
+  constexpr LocalAllocationBuffer() = default;
+  ~LocalAllocationBuffer() = default;
+
+  auto GetCurrentAddress() const -> uword {
+    return current_;
+  }
+
+  auto GetEndingAddress() const -> uword {
+    return end_;
+  }
+
+  auto GetNumberOfBytesRemaining() const -> uword {
+    return end_ - current_;
+  }
+
+  inline auto TryAllocate(const uword size) -> uword {
+    return TryAllocate(size, limit_);
+  }
+};
+
+class AllocationProfiler;
+class ConcurrentMarker;
+class Marker;
+class Sweeper;
 class Heap {
   friend class Collector;
+  friend class Marker;
+  friend class Sweeper;
+  friend class Compactor;
+  friend class ConcurrentMarker;
+  friend class HeapVerifier;
   DEFINE_NON_COPYABLE_TYPE(Heap);
 
  private:
   NewZone new_zone_;
   OldZone old_zone_;
+  LargeObjectSpace large_object_space_;
+  PointerList remembered_{};                        // old pointers w/ references into the new zone
+  std::unordered_set<Pointer**> remembered_slots_{};  // off-heap slots w/ references into the new zone
+  PointerList new_finalizers_{};                      // new pointers that own off-heap storage
+  PointerList old_finalizers_{};                      // old pointers that own off-heap storage
+  PointerList weak_{};                                // pointers w/ weak references, see Object::VisitWeakPointers
+  uword num_weak_cleared_ = 0;                        // the number of weak references cleared so far
+  std::unique_ptr<ConcurrentMarker> marker_{};        // the concurrent marking cycle in progress, if any
+  std::unique_ptr<Sweeper> sweeper_{};                // lazily sweeps the old zone after a concurrent marking cycle
+  GCStats stats_{};
+  std::unique_ptr<AllocationProfiler> profiler_{};  // set w/ --allocation_sample_interval
+
+  static inline thread_local LocalAllocationBuffer tlab_{};
+  // set on a mutator thread while the old zone of its Heap is being marked concurrently, see ConcurrentMarker.
+  static inline thread_local bool marking_ = false;
 
   Heap();
 
   void Clear();
+  auto RefillAllocationBuffer(const uword size) -> bool;
+  // counts the bytes allocated since the last call towards the next allocation sample & takes it once it's due.
+  void SampleAllocation(const uword address, const uword size, const char* type);
+  // allocates from the swept part of the OldZone, sweeping more pages on demand, Pointers allocated while marking
+  // concurrently start out marked.
+  auto TryAllocateOldOrSweep(const uword size) -> uword;
 
   inline auto new_zone() -> NewZone& {
     return new_zone_;
@@ -29,6 +133,10 @@ class Heap {
     return old_zone_;
   }
 
+  inline auto large_object_space() -> LargeObjectSpace& {
+    return large_object_space_;
+  }
+
  public:
   ~Heap();
 
@@ -42,7 +150,59 @@ class Heap {
   }
 
   auto TryAllocateNew(const uword size) -> uword;  // TODO: reduce visibility
-  auto TryAllocate(const uword size) -> uword;
+  // allocates an object >= kLargeObjectSize in its own pages of the LargeObjectSpace, it's never copied or compacted.
+  auto TryAllocateLarge(const uword size) -> uword;
+  auto TryAllocate(const uword size, const char* type = nullptr) -> uword;
+
+  // hands the unused tail of the current LocalAllocationBuffer back to the NewZone, called before a collection.
+  void RetireAllocationBuffer();
+  // hands the pages of the free OldZone chunks & the NewZone tospace back to the OS, called after a MajorCollection.
+  void ReleaseUnusedPages();
+
+  // the NewZone grows while few of the `allocated` bytes survive a MinorCollection & the pause is below the target.
+  static constexpr const uword kMaxNewZoneGrowthSurvivalRate = 10;
+  void ResizeNewZone(const uword allocated, const uword survived, const Clock::duration& pause);
+  // the OldZone grows when it remains mostly occupied after a MajorCollection.
+  static constexpr const uword kMaxOldZoneOccupancy = 75;
+  void ResizeOldZone();
+
+  void Remember(Pointer* ptr);
+  void RememberSlot(Pointer** slot);
+  void RememberOverwritten(Pointer* ptr);
+  // registers `ptr` to be finalized once it's collected, see Object::RegisterFinalizer.
+  void RegisterFinalizer(Pointer* ptr);
+  // runs the destructor of the dead `ptr`, releasing the off-heap storage it owns.
+  static void Finalize(Pointer* ptr);
+  // registers `ptr` to have its weak references cleared once their referents are collected.
+  void RegisterWeakPointers(Pointer* ptr);
+
+  auto IsConcurrentMarking() const -> bool {
+    return marker_ != nullptr;
+  }
+
+  auto IsSweeping() const -> bool;
+  auto ShouldStartConcurrentMarking() const -> bool;
+  // the initial mark pause, the old zone is then marked by a background thread.
+  void StartConcurrentMarking();
+  // the remark pause, the old zone is then swept lazily as it's allocated from.
+  void FinishConcurrentMarking();
+  // the marker thread sits out a minor collection, see ConcurrentMarker::Pause.
+  void PauseConcurrentMarking();
+  void ResumeConcurrentMarking();
+  void FinishSweeping();
+
+  auto GetRememberedSet() const -> const PointerList& {
+    return remembered_;
+  }
+
+  auto GetNumberOfFinalizers() const -> uword {
+    return new_finalizers_.size() + old_finalizers_.size();
+  }
+
+  // changes whenever a collection clears a weak reference, see EventLoop::RunFinalizers.
+  auto GetNumberOfWeakPointersCleared() const -> uword {
+    return num_weak_cleared_;
+  }
 
   auto GetNewZone() const -> const NewZone& {
     return new_zone_;
@@ -52,14 +212,39 @@ class Heap {
     return old_zone_;
   }
 
+  auto GetLargeObjectSpace() const -> const LargeObjectSpace& {
+    return large_object_space_;
+  }
+
+  auto GetStats() const -> const GCStats& {
+    return stats_;
+  }
+
+  auto IsProfilingAllocations() const -> bool {
+    return profiler_ != nullptr;
+  }
+
+  auto GetAllocationProfiler() const -> const AllocationProfiler* {
+    return profiler_.get();
+  }
+
+  // stamps `event` w/ the current occupancy of the Heap & adds it to the GCStats.
+  void RecordEvent(GCEvent& event);
+
+  auto GetNumberOfBytesAllocated() const -> uword {
+    return new_zone_.GetNumberOfBytesAllocated() + old_zone_.GetNumberOfBytesAllocated() +
+           large_object_space_.GetNumberOfBytesAllocated();
+  }
+
   auto GetTotalSize() const -> uword {
-    return new_zone_.GetSize() + old_zone_.GetSize();
+    return new_zone_.GetSize() + old_zone_.GetSize() + large_object_space_.GetNumberOfBytesAllocated();
   }
 
   friend auto operator<<(std::ostream& stream, const Heap& rhs) -> std::ostream& {
     stream << "Heap(";
     stream << "new_zone=" << rhs.new_zone_ << ", ";
-    stream << "old_zone=" << rhs.old_zone_;
+    stream << "old_zone=" << rhs.old_zone_ << ", ";
+    stream << "large_object_space=" << rhs.large_object_space_;
     stream << ")";
     return stream;
   }
@@ -67,8 +252,42 @@ class Heap {
  public:
   static auto GetHeap() -> Heap*;
   static void Init();
+
+  static inline auto GetLocalAllocationBuffer() -> const LocalAllocationBuffer& {
+    return tlab_;
+  }
+
+  static inline auto IsMarking() -> bool {
+    return marking_;
+  }
+
+  // the allocation fast path, bump allocates small objects from the LocalAllocationBuffer & only falls back to the
+  // Heap to refill the buffer, collect, sample or allocate large objects. `type` names the allocation in samples.
+  static inline auto Allocate(const uword size, const char* type = nullptr) -> uword {
+    ASSERT(size > 0);
+    if (size < kLargeObjectSize) {
+      const auto address = tlab_.TryAllocate(size);
+      if (address != UNALLOCATED)
+        return address;
+    }
+    const auto heap = GetHeap();
+    ASSERT(heap);
+    return heap->TryAllocate(size, type);
+  }
 };
 
+// snapshot-at-the-beginning barrier for the reference about to be overwritten, logs unmarked old pointers so the
+// concurrent marker still reaches everything that was live when marking started.
+static inline void PreWriteBarrier(Pointer* old_value) {
+#ifndef GEL_DISABLE_HEAP
+  if (!Heap::IsMarking() || IsUnallocated(old_value))
+    return;
+  const auto& tag = old_value->GetTag();
+  if (tag.IsOld() && !tag.IsMarked())
+    RememberOverwritten(old_value);
+#endif  // GEL_DISABLE_HEAP
+}
+
 #ifdef GEL_DEBUG
 
 void PrintHeap(Heap& heap);
@@ -0,0 +1,413 @@
+#include "gel/heap_snapshot.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "gel/collector.h"
+#include "gel/heap.h"
+#include "gel/object.h"
+#include "gel/zone.h"
+
+namespace gel {
+auto HeapSnapshot::GetClassIndex(std::unordered_map<std::string, uword>& classes, const std::string& name) -> uword {
+  const auto [pos, inserted] = classes.insert({name, classes_.size()});
+  if (inserted)
+    classes_.push_back(name);
+  return pos->second;
+}
+
+auto HeapSnapshot::AddNode(const std::string& cls, const uword size, const Space space, const std::vector<uword>& edges)
+    -> uword {
+  auto pos = std::find(classes_.begin(), classes_.end(), cls);
+  if (pos == classes_.end())
+    pos = classes_.insert(classes_.end(), cls);
+  Node node{};
+  node.cls = static_cast<uword>(std::distance(classes_.begin(), pos));
+  node.size = size;
+  node.space = space;
+  node.first_edge = edges_.size();
+  node.num_edges = edges.size();
+  edges_.insert(edges_.end(), edges.begin(), edges.end());
+  nodes_.push_back(node);
+  return nodes_.size() - 1;
+}
+
+void HeapSnapshot::AddRoot(const uword node) {
+  ASSERT(node >= 0 && node < GetNumberOfNodes());
+  roots_.push_back(node);
+}
+
+class HeapSnapshotEdgeVisitor : public PointerPointerVisitor {
+  DEFINE_NON_COPYABLE_TYPE(HeapSnapshotEdgeVisitor);
+
+ private:
+  const std::unordered_map<uword, uword>& nodes_;
+  std::vector<uword>& edges_;
+
+ public:
+  HeapSnapshotEdgeVisitor(const std::unordered_map<uword, uword>& nodes, std::vector<uword>& edges) :
+    PointerPointerVisitor(),
+    nodes_(nodes),
+    edges_(edges) {}
+  ~HeapSnapshotEdgeVisitor() override = default;
+
+  auto Visit(Pointer** ptr) -> bool override {
+    ASSERT(ptr);
+    if (IsUnallocated(*ptr))
+      return true;
+    // references to anything but a Pointer in the heap (e.g. a stale reference from an unswept Pointer) are dropped
+    const auto pos = nodes_.find((*ptr)->GetStartingAddress());
+    if (pos != nodes_.end())
+      edges_.push_back(pos->second);
+    return true;
+  }
+};
+
+static inline auto GetTypeName(Pointer* ptr) -> std::string {
+  const auto type = ptr->GetObjectPointer()->GetType();
+  if (!type || !type->GetName())
+    return "<unknown>";
+  return type->GetName()->Get();
+}
+
+void HeapSnapshot::Take(Heap& heap) {
+  // the tail of the LocalAllocationBuffer isn't parsable & unswept Pointers may reference freed memory
+  heap.RetireAllocationBuffer();
+  if (heap.IsSweeping())
+    heap.FinishSweeping();
+  std::vector<std::pair<Pointer*, Space>> ptrs{};
+  NewZone::Iterator iter(heap.GetNewZone());
+  while (iter.HasNext()) {
+    const auto next = iter.Next();
+    // retired LocalAllocationBuffers leave zeroed gaps & retired copy buffers leave free fillers behind
+    const auto& tag = next->GetTag();
+    if (!tag.IsInvalid() && !tag.IsFree())
+      ptrs.emplace_back(next, kNewSpace);
+  }
+  const auto& old_zone = heap.GetOldZone();
+  auto current = old_zone.GetStartingAddress();
+  while (current < old_zone.GetEndingAddress()) {
+    const auto next = Pointer::At(current);
+    if (!next->GetTag().IsFree())
+      ptrs.emplace_back(next, kOldSpace);
+    current += next->GetTotalSize();
+  }
+  heap.GetLargeObjectSpace().VisitPointers([&ptrs](Pointer* ptr) {
+    ptrs.emplace_back(ptr, kLargeObjectSpace);
+    return true;
+  });
+
+  std::unordered_map<uword, uword> nodes{};
+  nodes.reserve(ptrs.size());
+  for (uword idx = 0; idx < ptrs.size(); idx++)
+    nodes.insert({ptrs[idx].first->GetStartingAddress(), nodes_.size() + idx});
+  std::unordered_map<std::string, uword> classes{};
+  for (uword idx = 0; idx < classes_.size(); idx++)
+    classes.insert({classes_[idx], idx});
+  HeapSnapshotEdgeVisitor vis(nodes, edges_);
+  for (const auto& [ptr, space] : ptrs) {
+    Node node{};
+    node.cls = GetClassIndex(classes, GetTypeName(ptr));
+    node.size = ptr->GetTotalSize();
+    node.space = space;
+    node.first_edge = edges_.size();
+    LOG_IF(FATAL, !ptr->VisitPointers(&vis)) << "failed to visit: " << (*ptr);
+    node.num_edges = edges_.size() - node.first_edge;
+    nodes_.push_back(node);
+  }
+  LOG_IF(FATAL, !VisitRoots([this, &nodes](Pointer** ptr) {
+    const auto pos = nodes.find((*ptr)->GetStartingAddress());
+    if (pos != nodes.end())
+      AddRoot(pos->second);
+    return true;
+  })) << "failed to visit roots.";
+  DVLOG(1) << "took heap snapshot of " << GetNumberOfNodes() << " nodes & " << GetNumberOfEdges() << " edges.";
+}
+
+static inline void WriteUnsigned(std::ostream& stream, uword value) {
+  static constexpr const uword kMask = 0x7F;
+  static constexpr const uword kMore = 0x80;
+  do {
+    auto next = static_cast<uint8_t>(value & kMask);
+    value >>= 7;
+    if (value != 0)
+      next |= kMore;
+    stream.put(static_cast<char>(next));
+  } while (value != 0);
+}
+
+static inline auto ReadUnsigned(std::istream& stream, uword* result) -> bool {
+  static constexpr const uword kMask = 0x7F;
+  static constexpr const uword kMore = 0x80;
+  static constexpr const uword kMaxShift = 63;
+  uword value = 0;
+  uword shift = 0;
+  char next = 0;
+  do {
+    if (shift > kMaxShift || !stream.get(next))
+      return false;
+    value |= (static_cast<uword>(static_cast<uint8_t>(next)) & kMask) << shift;
+    shift += 7;
+  } while ((static_cast<uint8_t>(next) & kMore) != 0);
+  (*result) = value;
+  return true;
+}
+
+auto HeapSnapshot::WriteTo(std::ostream& stream) const -> bool {
+  WriteUnsigned(stream, kMagic);
+  WriteUnsigned(stream, kVersion);
+  WriteUnsigned(stream, classes_.size());
+  for (const auto& cls : classes_) {
+    WriteUnsigned(stream, cls.size());
+    stream.write(cls.data(), static_cast<std::streamsize>(cls.size()));
+  }
+  WriteUnsigned(stream, nodes_.size());
+  for (const auto& node : nodes_) {
+    WriteUnsigned(stream, node.cls);
+    WriteUnsigned(stream, node.size);
+    WriteUnsigned(stream, node.space);
+    WriteUnsigned(stream, node.num_edges);
+    for (uword idx = 0; idx < node.num_edges; idx++)
+      WriteUnsigned(stream, GetEdge(node, idx));
+  }
+  WriteUnsigned(stream, roots_.size());
+  for (const auto& root : roots_)
+    WriteUnsigned(stream, root);
+  return stream.good();
+}
+
+auto HeapSnapshot::ReadFrom(std::istream& stream) -> bool {
+  uword magic = 0;
+  uword version = 0;
+  if (!ReadUnsigned(stream, &magic) || magic != kMagic) {
+    LOG(ERROR) << "not a heap snapshot.";
+    return false;
+  }
+  if (!ReadUnsigned(stream, &version) || version != kVersion) {
+    LOG(ERROR) << "unsupported heap snapshot version: " << version;
+    return false;
+  }
+  uword num_classes = 0;
+  if (!ReadUnsigned(stream, &num_classes))
+    return false;
+  classes_.clear();
+  for (uword idx = 0; idx < num_classes; idx++) {
+    uword length = 0;
+    if (!ReadUnsigned(stream, &length))
+      return false;
+    std::string cls(length, '\0');
+    if (!stream.read(cls.data(), static_cast<std::streamsize>(length)))
+      return false;
+    classes_.push_back(cls);
+  }
+  uword num_nodes = 0;
+  if (!ReadUnsigned(stream, &num_nodes))
+    return false;
+  nodes_.clear();
+  edges_.clear();
+  for (uword idx = 0; idx < num_nodes; idx++) {
+    Node node{};
+    uword space = 0;
+    if (!ReadUnsigned(stream, &node.cls) || !ReadUnsigned(stream, &node.size) || !ReadUnsigned(stream, &space) ||
+        !ReadUnsigned(stream, &node.num_edges))
+      return false;
+    if (node.cls >= num_classes || space >= kNumberOfSpaces) {
+      LOG(ERROR) << "invalid heap snapshot node #" << idx;
+      return false;
+    }
+    node.space = static_cast<Space>(space);
+    node.first_edge = edges_.size();
+    for (uword edge = 0; edge < node.num_edges; edge++) {
+      uword target = 0;
+      if (!ReadUnsigned(stream, &target) || target >= num_nodes)
+        return false;
+      edges_.push_back(target);
+    }
+    nodes_.push_back(node);
+  }
+  uword num_roots = 0;
+  if (!ReadUnsigned(stream, &num_roots))
+    return false;
+  roots_.clear();
+  for (uword idx = 0; idx < num_roots; idx++) {
+    uword root = 0;
+    if (!ReadUnsigned(stream, &root) || root >= num_nodes)
+      return false;
+    roots_.push_back(root);
+  }
+  return true;
+}
+
+auto HeapSnapshot::WriteTo(const std::string& filename) const -> bool {
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream) {
+    LOG(ERROR) << "failed to open: " << filename;
+    return false;
+  }
+  return WriteTo(stream);
+}
+
+auto HeapSnapshot::ReadFrom(const std::string& filename) -> bool {
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream) {
+    LOG(ERROR) << "failed to open: " << filename;
+    return false;
+  }
+  return ReadFrom(stream);
+}
+
+HeapSnapshotAnalysis::HeapSnapshotAnalysis(const HeapSnapshot& snapshot) :
+  snapshot_(snapshot),
+  dominators_(snapshot.GetNumberOfNodes() + 1, kNoDominator),
+  retained_(snapshot.GetNumberOfNodes(), 0) {
+  ComputeDominators();
+  ComputeRetainedSizes();
+}
+
+/*
+ * Cooper, Harvey & Kennedy's "A Simple, Fast Dominance Algorithm":
+ *  -- number the nodes reachable from the virtual root (whose successors are the roots) in post order
+ *  -- iterate over the nodes in reverse post order, intersecting the dominators of each node's processed predecessors
+ *     until none of the dominators change
+ */
+void HeapSnapshotAnalysis::ComputeDominators() {
+  const auto num_nodes = snapshot_.GetNumberOfNodes();
+  const auto root = GetRoot();
+  const auto get_successor = [this, root](const uword node, const uword idx) {
+    return node == root ? snapshot_.GetRoots()[idx] : snapshot_.GetEdge(snapshot_.GetNode(node), idx);
+  };
+  const auto get_number_of_successors = [this, root](const uword node) {
+    return node == root ? snapshot_.GetRoots().size() : snapshot_.GetNode(node).num_edges;
+  };
+
+  static constexpr const uword kUnvisited = static_cast<uword>(-1);
+  std::vector<uword> order(num_nodes + 1, kUnvisited);  // the post order number of each node
+  std::vector<std::pair<uword, uword>> work{};          // (node, next successor)
+  postorder_.clear();
+  order[root] = 0;
+  work.emplace_back(root, 0);
+  while (!work.empty()) {
+    auto& [node, next] = work.back();
+    if (next < get_number_of_successors(node)) {
+      const auto successor = get_successor(node, next++);
+      if (order[successor] == kUnvisited) {
+        order[successor] = 0;
+        work.emplace_back(successor, 0);
+      }
+      continue;
+    }
+    if (node != root) {
+      order[node] = postorder_.size();
+      postorder_.push_back(node);
+    }
+    work.pop_back();
+  }
+  order[root] = postorder_.size();
+
+  // the predecessors of the reachable nodes, the roots are preceded by the virtual root
+  std::vector<std::vector<uword>> predecessors(num_nodes);
+  for (const auto& node : postorder_) {
+    for (uword idx = 0; idx < get_number_of_successors(node); idx++)
+      predecessors[get_successor(node, idx)].push_back(node);
+  }
+  for (const auto& node : snapshot_.GetRoots())
+    predecessors[node].push_back(root);
+
+  const auto intersect = [this, &order](uword lhs, uword rhs) {
+    while (lhs != rhs) {
+      while (order[lhs] < order[rhs])
+        lhs = dominators_[lhs];
+      while (order[rhs] < order[lhs])
+        rhs = dominators_[rhs];
+    }
+    return lhs;
+  };
+  dominators_[root] = root;
+  auto changed = true;
+  while (changed) {
+    changed = false;
+    for (auto pos = postorder_.rbegin(); pos != postorder_.rend(); pos++) {
+      const auto node = (*pos);
+      auto dominator = kNoDominator;
+      for (const auto& predecessor : predecessors[node]) {
+        if (dominators_[predecessor] == kNoDominator)
+          continue;
+        dominator = dominator == kNoDominator ? predecessor : intersect(predecessor, dominator);
+      }
+      if (dominators_[node] != dominator) {
+        dominators_[node] = dominator;
+        changed = true;
+      }
+    }
+  }
+}
+
+void HeapSnapshotAnalysis::ComputeRetainedSizes() {
+  for (const auto& node : postorder_)
+    retained_[node] += snapshot_.GetNode(node).size;
+  // a node's dominator always comes later in the post order
+  for (const auto& node : postorder_) {
+    const auto dominator = GetDominator(node);
+    if (dominator != kNoDominator)
+      retained_[dominator] += retained_[node];
+  }
+}
+
+auto HeapSnapshotAnalysis::GetNumberOfBytesReachable() const -> uword {
+  uword total = 0;
+  for (const auto& node : postorder_)
+    total += snapshot_.GetNode(node).size;
+  return total;
+}
+
+auto HeapSnapshotAnalysis::GetClassStats() const -> std::vector<ClassStats> {
+  const auto& classes = snapshot_.GetClasses();
+  std::vector<ClassStats> stats(classes.size());
+  for (uword idx = 0; idx < classes.size(); idx++)
+    stats[idx].name = classes[idx];
+  // walks the dominator tree, only counting the outermost instance of each Class on the path from the root
+  std::vector<std::vector<uword>> children(snapshot_.GetNumberOfNodes() + 1);
+  for (const auto& node : postorder_)
+    children[dominators_[node]].push_back(node);
+  std::vector<uword> active(classes.size(), 0);
+  std::vector<std::pair<uword, bool>> work{};  // (node, exiting)
+  for (const auto& node : children[GetRoot()])
+    work.emplace_back(node, false);
+  while (!work.empty()) {
+    const auto [node, exiting] = work.back();
+    work.pop_back();
+    const auto& value = snapshot_.GetNode(node);
+    if (exiting) {
+      active[value.cls] -= 1;
+      continue;
+    }
+    auto& cls = stats[value.cls];
+    cls.count += 1;
+    cls.shallow_size += value.size;
+    if (active[value.cls] == 0)
+      cls.retained_size += GetRetainedSize(node);
+    active[value.cls] += 1;
+    work.emplace_back(node, true);
+    for (const auto& child : children[node])
+      work.emplace_back(child, false);
+  }
+  std::erase_if(stats, [](const ClassStats& cls) {
+    return cls.count == 0;
+  });
+  std::sort(stats.begin(), stats.end(), [](const ClassStats& lhs, const ClassStats& rhs) {
+    return lhs.retained_size > rhs.retained_size;
+  });
+  return stats;
+}
+
+auto HeapSnapshotAnalysis::GetTopRetainers(const uword num) const -> std::vector<uword> {
+  std::vector<uword> nodes(postorder_);
+  const auto count = std::min(num, static_cast<uword>(nodes.size()));
+  std::partial_sort(nodes.begin(), nodes.begin() + static_cast<word>(count), nodes.end(),
+                    [this](const uword lhs, const uword rhs) {
+                      return GetRetainedSize(lhs) > GetRetainedSize(rhs);
+                    });
+  nodes.resize(count);
+  return nodes;
+}
+}  // namespace gel
@@ -0,0 +1,154 @@
+#ifndef GEL_HEAP_SNAPSHOT_H
+#define GEL_HEAP_SNAPSHOT_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gel/common.h"
+
+namespace gel {
+class Heap;
+// a copy of the object graph of a Heap, each Pointer is recorded w/ its Class, size & outgoing references. Snapshots
+// are written in a compact binary format (LEB128 encoded) & analyzed offline, see HeapSnapshotAnalysis.
+class HeapSnapshot {
+  DEFINE_NON_COPYABLE_TYPE(HeapSnapshot);
+
+ public:
+  static constexpr const uint32_t kMagic = 0x534C4547;  // "GELS"
+  static constexpr const uword kVersion = 1;
+
+  enum Space : uint8_t {
+    kNewSpace = 0,
+    kOldSpace,
+    kLargeObjectSpace,
+    kNumberOfSpaces,
+  };
+
+  struct Node {
+    uword cls = 0;   // the index of the Class name
+    uword size = 0;  // the total size of the Pointer in bytes
+    Space space = kNewSpace;
+    uword first_edge = 0;
+    uword num_edges = 0;
+  };
+
+ private:
+  std::vector<std::string> classes_{};
+  std::vector<Node> nodes_{};
+  std::vector<uword> edges_{};  // the referenced node of each edge, grouped by node
+  std::vector<uword> roots_{};
+
+  auto GetClassIndex(std::unordered_map<std::string, uword>& classes, const std::string& name) -> uword;
+
+ public:
+  HeapSnapshot() = default;
+  ~HeapSnapshot() = default;
+
+  auto GetNumberOfNodes() const -> uword {
+    return nodes_.size();
+  }
+
+  auto GetNumberOfEdges() const -> uword {
+    return edges_.size();
+  }
+
+  auto GetNode(const uword idx) const -> const Node& {
+    ASSERT(idx >= 0 && idx < GetNumberOfNodes());
+    return nodes_[idx];
+  }
+
+  auto GetEdge(const Node& node, const uword idx) const -> uword {
+    ASSERT(idx >= 0 && idx < node.num_edges);
+    return edges_[node.first_edge + idx];
+  }
+
+  auto GetClassName(const Node& node) const -> const std::string& {
+    ASSERT(node.cls >= 0 && node.cls < classes_.size());
+    return classes_[node.cls];
+  }
+
+  auto GetClasses() const -> const std::vector<std::string>& {
+    return classes_;
+  }
+
+  auto GetRoots() const -> const std::vector<uword>& {
+    return roots_;
+  }
+
+  // adds a node referencing the nodes in `edges`, returns its index.
+  auto AddNode(const std::string& cls, const uword size, const Space space, const std::vector<uword>& edges) -> uword;
+  void AddRoot(const uword node);
+  // records every Pointer in the NewZone, OldZone & LargeObjectSpace of `heap`, the heap must not be collected while
+  // the snapshot is taken.
+  void Take(Heap& heap);
+  auto WriteTo(std::ostream& stream) const -> bool;
+  auto ReadFrom(std::istream& stream) -> bool;
+  auto WriteTo(const std::string& filename) const -> bool;
+  auto ReadFrom(const std::string& filename) -> bool;
+};
+
+// the dominator tree of a HeapSnapshot, a node dominates every node that's only reachable from the roots through it.
+// The retained size of a node is the total size of the nodes it dominates, i.e. the bytes freed once it's unreachable.
+class HeapSnapshotAnalysis {
+  DEFINE_NON_COPYABLE_TYPE(HeapSnapshotAnalysis);
+
+ public:
+  static constexpr const uword kNoDominator = static_cast<uword>(-1);
+
+  struct ClassStats {
+    std::string name{};
+    uword count = 0;
+    uword shallow_size = 0;
+    uword retained_size = 0;  // excludes the instances retained by another instance of the same Class
+  };
+
+ private:
+  const HeapSnapshot& snapshot_;
+  std::vector<uword> postorder_{};   // the reachable nodes in the post order of a depth first search from the roots
+  std::vector<uword> dominators_{};  // the immediate dominator of each node, the virtual root is GetRoot()
+  std::vector<uword> retained_{};
+
+  auto GetRoot() const -> uword {
+    return snapshot_.GetNumberOfNodes();
+  }
+
+  void ComputeDominators();
+  void ComputeRetainedSizes();
+
+ public:
+  explicit HeapSnapshotAnalysis(const HeapSnapshot& snapshot);
+  ~HeapSnapshotAnalysis() = default;
+
+  auto GetSnapshot() const -> const HeapSnapshot& {
+    return snapshot_;
+  }
+
+  auto IsReachable(const uword node) const -> bool {
+    ASSERT(node >= 0 && node < snapshot_.GetNumberOfNodes());
+    return dominators_[node] != kNoDominator;
+  }
+
+  // the immediate dominator of `node`, or kNoDominator if it's only dominated by the roots (or unreachable).
+  auto GetDominator(const uword node) const -> uword {
+    ASSERT(node >= 0 && node < snapshot_.GetNumberOfNodes());
+    const auto dominator = dominators_[node];
+    return dominator == GetRoot() ? kNoDominator : dominator;
+  }
+
+  auto GetRetainedSize(const uword node) const -> uword {
+    ASSERT(node >= 0 && node < snapshot_.GetNumberOfNodes());
+    return retained_[node];
+  }
+
+  auto GetNumberOfBytesReachable() const -> uword;
+  // the reachable instances of each Class, sorted by their retained size.
+  auto GetClassStats() const -> std::vector<ClassStats>;
+  // the `num` reachable nodes retaining the most bytes.
+  auto GetTopRetainers(const uword num) const -> std::vector<uword>;
+};
+}  // namespace gel
+
+#endif  // GEL_HEAP_SNAPSHOT_H
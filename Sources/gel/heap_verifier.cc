@@ -0,0 +1,272 @@
+#include "gel/heap_verifier.h"
+
+#include <sstream>
+
+#include "gel/collector.h"
+#include "gel/free_list.h"
+#include "gel/heap.h"
+#include "gel/immortal_space.h"
+#include "gel/memory_region.h"
+#include "gel/object.h"
+#include "gel/zone.h"
+
+namespace gel {
+DEFINE_bool(verify_heap, false, "Verify the heap before & after every collection, aborting on the first corruption.");
+
+void HeapVerifier::ReportError(const std::string& error) {
+  num_errors_ += 1;
+  if (errors_.size() < kMaxNumberOfErrors)
+    errors_.push_back(error);
+}
+
+void HeapVerifier::ReportError(Pointer* ptr, const std::string& error) {
+  std::stringstream ss;
+  ss << error << ": " << (*ptr);
+  return ReportError(ss.str());
+}
+
+auto HeapVerifier::VerifyPointer(Pointer* ptr, const uword start, const uword end) -> bool {
+  ASSERT(ptr);
+  const auto& tag = ptr->GetTag();
+  if (tag.IsInvalid() || ptr->GetTotalSize() < sizeof(Pointer)) {
+    ReportError(ptr, "invalid tag");
+    return false;
+  }
+  if ((ptr->GetStartingAddress() % kWordSize) != 0 || ptr->GetStartingAddress() < start ||
+      ptr->GetEndingAddress() > end) {
+    ReportError(ptr, "Pointer out of bounds");
+    return false;
+  }
+  if (tag.IsNew() && tag.IsOld()) {
+    ReportError(ptr, "Pointer is both new & old");
+    return false;
+  }
+  if (!tag.IsFree() && ptr->IsForwarding()) {
+    ReportError(ptr, "Pointer is still forwarding");
+    return false;
+  }
+  return true;
+}
+
+void HeapVerifier::VerifyNewZone() {
+  const auto& zone = heap().GetNewZone();
+  const auto start = zone.fromspace();
+  const auto end = zone.GetCurrentAddress();
+  if (end < start || end > (start + zone.semisize())) {
+    ReportError(fmt::format("the NewZone's current address {:#x} is outside of the fromspace", end));
+    return;
+  }
+  const auto& tlab = Heap::GetLocalAllocationBuffer();
+  auto current = start;
+  while (current < end) {
+    // the unused tail of the current LocalAllocationBuffer isn't parsable until it's retired
+    if (current == tlab.GetCurrentAddress() && tlab.GetEndingAddress() <= end) {
+      current = tlab.GetEndingAddress();
+      continue;
+    }
+    const auto next = Pointer::At(current);
+    const auto& tag = next->GetTag();
+    // retired LocalAllocationBuffers leave zeroed gaps & retired copy buffers leave free fillers behind
+    if (tag.IsInvalid() && next->GetForwardingAddress() == UNALLOCATED) {
+      current += sizeof(Pointer);
+      continue;
+    }
+    if (!VerifyPointer(next, start, end))
+      return;  // the rest of the zone isn't parsable
+    current += next->GetTotalSize();
+    if (tag.IsFree())
+      continue;
+    if (!tag.IsNew())
+      ReportError(next, "old Pointer in the NewZone");
+    pointers_.insert(next->GetStartingAddress());
+  }
+}
+
+void HeapVerifier::VerifyOldZone() {
+  const auto& zone = heap().GetOldZone();
+  auto current = zone.GetStartingAddress();
+  while (current < zone.GetEndingAddress()) {
+    const auto next = Pointer::At(current);
+    if (!VerifyPointer(next, zone.GetStartingAddress(), zone.GetEndingAddress()))
+      return;  // the rest of the zone isn't parsable
+    const auto& tag = next->GetTag();
+    if (tag.IsFree()) {
+      free_.insert(current);
+    } else {
+      if (!tag.IsOld())
+        ReportError(next, "new Pointer in the OldZone");
+      pointers_.insert(current);
+    }
+    current += next->GetTotalSize();
+  }
+  if (current != zone.GetEndingAddress())
+    ReportError(fmt::format("the OldZone ends at {:#x} instead of {:#x}", current, zone.GetEndingAddress()));
+}
+
+// every chunk in the FreeList must be a free chunk of the OldZone, in the bucket of its size class.
+void HeapVerifier::VerifyFreeList() {
+  const auto& free_list = heap().GetOldZone().free_list();
+  std::unordered_set<uword> seen{};
+  uword num_free = 0;
+  for (word size_class = 0; size_class < FreeList::kNumberOfSizeClasses; size_class++) {
+    auto current = free_list.GetBucket(size_class);
+    while (current != nullptr) {
+      const auto address = current->GetStartingAddress();
+      if (!free_.contains(address)) {
+        ReportError(fmt::format("FreeList chunk {:#x} isn't a free chunk of the OldZone", address));
+        return;  // the chunk can't be trusted to link to the next one
+      }
+      if (!seen.insert(address).second) {
+        ReportError(fmt::format("FreeList chunk {:#x} is linked more than once", address));
+        return;
+      }
+      if (FreeList::GetSizeClass(current->GetTotalSize()) != size_class)
+        ReportError(fmt::format("FreeList chunk {:#x} is in size class {} instead of {}", address, size_class,
+                                FreeList::GetSizeClass(current->GetTotalSize())));
+      num_free += current->GetTotalSize();
+      current = current->GetNext();
+    }
+  }
+  if (num_free != free_list.GetNumberOfBytesFree())
+    ReportError(fmt::format("the FreeList counts {} free bytes, but links {}", free_list.GetNumberOfBytesFree(), num_free));
+}
+
+void HeapVerifier::VerifyLargeObjectSpace() {
+  const auto& space = heap().GetLargeObjectSpace();
+  space.VisitPointers([this, &space](Pointer* ptr) {
+    if (!VerifyPointer(ptr, space.GetStartingAddress(), space.GetEndingAddress()))
+      return true;
+    const auto& tag = ptr->GetTag();
+    if (tag.IsFree() || !tag.IsOld())
+      ReportError(ptr, "large object isn't old");
+    if ((ptr->GetStartingAddress() % MemoryRegion::GetPageSize()) != 0)
+      ReportError(ptr, "large object isn't page aligned");
+    pointers_.insert(ptr->GetStartingAddress());
+    return true;
+  });
+}
+
+auto HeapVerifier::Visit(Pointer** ptr) -> bool {
+  ASSERT(ptr);
+  const auto next = (*ptr);
+  // immortal Objects (e.g. Smis) live outside of the heap & are never moved or collected
+  if (IsUnallocated(next) || IsImmortal(next))
+    return true;
+  if (!pointers_.contains(next->GetStartingAddress())) {
+    if (current_)
+      ReportError(current_, fmt::format("reference to {} isn't a Pointer in the heap", next->GetStartingAddressPointer()));
+    else
+      ReportError(fmt::format("root {} isn't a Pointer in the heap", next->GetStartingAddressPointer()));
+    return true;
+  }
+  // old Pointers w/ references into the NewZone must be remembered, or the next minor collection misses them. off-heap
+  // slots (e.g. LocalVariables) are remembered by themselves.
+  if (current_ && next->GetTag().IsNew() && current_->GetTag().IsOld() && !current_->GetTag().IsRemembered() &&
+      !heap().remembered_slots_.contains(ptr))
+    ReportError(current_, fmt::format("unremembered reference to new Pointer {}", next->GetStartingAddressPointer()));
+  if (visited_.insert(next->GetStartingAddress()).second)
+    work_.push_back(next);
+  return true;
+}
+
+// only the Pointers reachable from the roots are traced, the references of unswept garbage may be stale.
+void HeapVerifier::VerifyReferences() {
+  current_ = nullptr;
+  LOG_IF(FATAL, !VisitRoots(this)) << "failed to visit roots.";
+  while (!work_.empty()) {
+    current_ = work_.back();
+    work_.pop_back();
+    LOG_IF(FATAL, !current_->VisitPointers(this)) << "failed to visit: " << (*current_);
+  }
+  current_ = nullptr;
+}
+
+void HeapVerifier::VerifyRememberedSet() {
+  for (const auto& ptr : heap().GetRememberedSet()) {
+    if (!pointers_.contains(ptr->GetStartingAddress())) {
+      ReportError(fmt::format("remembered {} isn't a Pointer in the heap", ptr->GetStartingAddressPointer()));
+      continue;
+    }
+    if (!ptr->GetTag().IsOld() || !ptr->GetTag().IsRemembered())
+      ReportError(ptr, "remembered Pointer isn't an old Pointer w/ the remembered bit set");
+  }
+}
+
+void HeapVerifier::VerifyFinalizers() {
+  const auto verify = [this](const PointerList& finalizers, const bool old) {
+    for (const auto& ptr : finalizers) {
+      if (!pointers_.contains(ptr->GetStartingAddress())) {
+        ReportError(fmt::format("finalizable {} isn't a Pointer in the heap", ptr->GetStartingAddressPointer()));
+        continue;
+      }
+      if (ptr->GetTag().IsOld() != old)
+        ReportError(ptr, "finalizable Pointer is registered in the wrong generation");
+    }
+  };
+  verify(heap().new_finalizers_, false);
+  verify(heap().old_finalizers_, true);
+}
+
+class WeakReferentVerifier : public PointerPointerVisitor {
+  DEFINE_NON_COPYABLE_TYPE(WeakReferentVerifier);
+
+ private:
+  const std::unordered_set<uword>& pointers_;
+  uword num_invalid_ = 0;
+
+ public:
+  explicit WeakReferentVerifier(const std::unordered_set<uword>& pointers) :
+    PointerPointerVisitor(),
+    pointers_(pointers) {}
+  ~WeakReferentVerifier() override = default;
+
+  auto GetNumberOfInvalidReferents() const -> uword {
+    return num_invalid_;
+  }
+
+  auto Visit(Pointer** ptr) -> bool override {
+    ASSERT(ptr);
+    if (!IsUnallocated(*ptr) && !pointers_.contains((*ptr)->GetStartingAddress()))
+      num_invalid_ += 1;
+    return true;
+  }
+};
+
+// the referents of weak references are cleared before they're swept, so they must still be Pointers in the heap.
+void HeapVerifier::VerifyWeakPointers() {
+  for (const auto& ptr : heap().weak_) {
+    if (!pointers_.contains(ptr->GetStartingAddress())) {
+      ReportError(fmt::format("weak {} isn't a Pointer in the heap", ptr->GetStartingAddressPointer()));
+      continue;
+    }
+    WeakReferentVerifier verifier(pointers_);
+    LOG_IF(FATAL, !ptr->VisitWeakPointers(&verifier)) << "failed to visit weak references of: " << (*ptr);
+    if (verifier.GetNumberOfInvalidReferents() > 0)
+      ReportError(ptr, fmt::format("{} weak references to Pointers outside of the heap",
+                                   verifier.GetNumberOfInvalidReferents()));
+  }
+}
+
+auto HeapVerifier::Verify() -> bool {
+  VerifyNewZone();
+  VerifyOldZone();
+  VerifyFreeList();
+  VerifyLargeObjectSpace();
+  VerifyRememberedSet();
+  VerifyFinalizers();
+  VerifyWeakPointers();
+  VerifyReferences();
+  return GetNumberOfErrors() == 0;
+}
+
+void VerifyHeap(Heap& heap, const char* phase) {
+  HeapVerifier verifier(heap);
+  if (verifier.Verify()) {
+    DVLOG(1) << "verified heap " << phase << ".";
+    return;
+  }
+  for (const auto& error : verifier.GetErrors())
+    LOG(ERROR) << error;
+  LOG(FATAL) << "found " << verifier.GetNumberOfErrors() << " errors in the heap " << phase << ": " << heap;
+}
+}  // namespace gel
@@ -0,0 +1,80 @@
+#ifndef GEL_HEAP_VERIFIER_H
+#define GEL_HEAP_VERIFIER_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gel/common.h"
+#include "gel/flags.h"
+#include "gel/pointer.h"
+
+namespace gel {
+DECLARE_bool(verify_heap);
+
+static inline auto ShouldVerifyHeap() -> bool {
+  return FLAGS_verify_heap;
+}
+
+class Heap;
+// walks every zone of a Heap checking that it's parsable & that the Pointers reachable from the roots only reference
+// valid Pointers, used w/ --verify_heap to catch collector bugs at the collection that caused them.
+class HeapVerifier : public PointerPointerVisitor {
+  DEFINE_NON_COPYABLE_TYPE(HeapVerifier);
+
+ public:
+  static constexpr const uword kMaxNumberOfErrors = 16;
+
+ private:
+  Heap& heap_;
+  std::unordered_set<uword> pointers_{};  // the starting address of every (non-free) Pointer in the heap
+  std::unordered_set<uword> free_{};      // the starting address of every free chunk in the OldZone
+  std::unordered_set<uword> visited_{};
+  PointerList work_{};
+  Pointer* current_ = nullptr;  // the Pointer whose references are being visited, or null while visiting the roots
+  std::vector<std::string> errors_{};
+  uword num_errors_ = 0;
+
+  inline auto heap() const -> Heap& {
+    return heap_;
+  }
+
+  void ReportError(const std::string& error);
+  void ReportError(Pointer* ptr, const std::string& error);
+  // checks the header of `ptr`, which must lie within [start, end).
+  auto VerifyPointer(Pointer* ptr, const uword start, const uword end) -> bool;
+  void VerifyNewZone();
+  void VerifyOldZone();
+  void VerifyFreeList();
+  void VerifyLargeObjectSpace();
+  void VerifyReferences();
+  void VerifyRememberedSet();
+  void VerifyFinalizers();
+  void VerifyWeakPointers();
+
+ protected:
+  auto Visit(Pointer** ptr) -> bool override;
+
+ public:
+  explicit HeapVerifier(Heap& heap) :
+    PointerPointerVisitor(),
+    heap_(heap) {}
+  ~HeapVerifier() override = default;
+
+  auto GetNumberOfErrors() const -> uword {
+    return num_errors_;
+  }
+
+  // the first kMaxNumberOfErrors errors found.
+  auto GetErrors() const -> const std::vector<std::string>& {
+    return errors_;
+  }
+
+  auto Verify() -> bool;
+};
+
+// verifies `heap` & aborts w/ the errors found, `phase` names the point of the collection it's called at.
+void VerifyHeap(Heap& heap, const char* phase);
+}  // namespace gel
+
+#endif  // GEL_HEAP_VERIFIER_H
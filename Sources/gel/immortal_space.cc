@@ -0,0 +1,40 @@
+#include "gel/immortal_space.h"
+
+#include <glog/logging.h>
+
+#include "gel/memory_region.h"
+
+namespace gel {
+uword ImmortalSpace::start_ = UNALLOCATED;    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uword ImmortalSpace::current_ = UNALLOCATED;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uword ImmortalSpace::end_ = UNALLOCATED;      // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+bool ImmortalSpace::protected_ = false;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void ImmortalSpace::Init() {
+  ASSERT(start_ == UNALLOCATED);
+  // never freed, immortal Objects are referenced from anywhere & outlive every Heap
+  const MemoryRegion region(RoundUp(kSize, MemoryRegion::GetPageSize()), MemoryRegion::kReadWrite);
+  LOG_IF(FATAL, !region.IsAllocated()) << "failed to allocate the ImmortalSpace.";
+  start_ = current_ = region.GetStartingAddress();
+  end_ = region.GetEndingAddress();
+}
+
+auto ImmortalSpace::Allocate(const uword size) -> uword {
+  ASSERT(start_ != UNALLOCATED);
+  LOG_IF(FATAL, IsProtected()) << "cannot allocate " << size << "b in the ImmortalSpace once it's protected.";
+  const auto total_size = RoundUp(sizeof(Pointer) + size, kWordSize);
+  LOG_IF(FATAL, (current_ + total_size) > end_) << "cannot allocate " << size << "b in the ImmortalSpace.";
+  const auto ptr = Pointer::New(current_, Tag::Unmanaged(total_size - sizeof(Pointer)));
+  ASSERT(ptr);
+  current_ += total_size;
+  return ptr->GetObjectAddress();
+}
+
+void ImmortalSpace::Protect() {
+  ASSERT(start_ != UNALLOCATED);
+  MemoryRegion region(start_, end_ - start_);
+  region.Protect(MemoryRegion::kReadOnly);
+  protected_ = true;
+  DVLOG(1) << "protected the ImmortalSpace w/ " << GetNumberOfBytesAllocated() << "b allocated.";
+}
+}  // namespace gel
@@ -0,0 +1,52 @@
+#ifndef GEL_IMMORTAL_SPACE_H
+#define GEL_IMMORTAL_SPACE_H
+
+#include "gel/common.h"
+#include "gel/platform.h"
+#include "gel/pointer.h"
+
+namespace gel {
+// a read-only region holding the canonical Objects created by Object::Init (e.g. Smis, #t, #f & the empty list). its
+// Pointers are neither new nor old, so the collector never scans, moves, frees or finalizes them. immortal Objects are
+// immutable & must only reference other immortal Objects.
+class ImmortalSpace {
+  DEFINE_NON_COPYABLE_TYPE(ImmortalSpace);
+
+ public:
+  static constexpr const uword kSize = 1 * 1024 * 1024;
+
+ private:
+  static uword start_;     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static uword current_;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static uword end_;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static bool protected_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+ public:
+  ImmortalSpace() = delete;
+  ~ImmortalSpace() = delete;
+
+  static void Init();
+  // bump allocates an immortal object of `size` bytes, returns the address of the object.
+  static auto Allocate(const uword size) -> uword;
+  // write protects the ImmortalSpace once every canonical Object has been created, nothing can be allocated afterwards.
+  static void Protect();
+
+  static inline auto IsProtected() -> bool {
+    return protected_;
+  }
+
+  static inline auto Contains(const uword address) -> bool {
+    return address >= start_ && address < current_;
+  }
+
+  static inline auto GetNumberOfBytesAllocated() -> uword {
+    return current_ - start_;
+  }
+};
+
+static inline auto IsImmortal(Pointer* ptr) -> bool {
+  return !IsUnallocated(ptr) && ImmortalSpace::Contains(ptr->GetStartingAddress());
+}
+}  // namespace gel
+
+#endif  // GEL_IMMORTAL_SPACE_H
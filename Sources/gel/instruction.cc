@@ -159,6 +159,18 @@ auto InvokeInstr::ToString() const -> std::string {
   return helper;
 }
 
+auto InvokeInstr::IsInTailPosition() const -> bool {
+  const auto next = GetNext();
+  if (!next)
+    return false;
+  if (next->IsReturnInstr())
+    return true;
+  if (!next->IsGotoInstr())
+    return false;
+  const auto target = next->AsGotoInstr()->GetTarget();
+  return target && target->HasNext() && target->GetNext()->IsReturnInstr();
+}
+
 auto InvokeDynamicInstr::ToString() const -> std::string {
   ToStringHelper<InvokeDynamicInstr> helper;
   helper.AddField("target", GetTarget());
@@ -474,6 +474,9 @@ class InvokeInstr : public Definition {
     return GetTarget()->AsConstantInstr()->GetValue()->AsProcedure();
   }
 
+  // true when the result is returned right away, either directly or through the join of a cond.
+  auto IsInTailPosition() const -> bool;
+
   DECLARE_INSTRUCTION(InvokeInstr);
 
  public:
@@ -29,11 +29,13 @@ void ConstantInstr::Compile(FlowGraphCompiler* compiler) {
 
 void StoreLocalInstr::Compile(FlowGraphCompiler* compiler) {
   ASSERT(compiler);
+  compiler->UseLocal(GetLocal()->GetIndex());
   __ StoreLocal(GetLocal()->GetIndex());
 }
 
 void LoadLocalInstr::Compile(FlowGraphCompiler* compiler) {
   ASSERT(compiler);
+  compiler->UseLocal(GetLocal()->GetIndex());
   __ LoadLocal(GetLocal()->GetIndex());
 }
 
@@ -113,6 +115,9 @@ void UnaryOpInstr::Compile(FlowGraphCompiler* compiler) {
 void InvokeInstr::Compile(FlowGraphCompiler* compiler) {
   ASSERT(compiler);
   ASSERT(GetProcedure()->IsLambda());
+  // the ret that follows is still emitted, it's only reached when the tail call falls back to a regular call
+  if (IsInTailPosition())
+    return __ tailinvoke(GetProcedure()->AsLambda(), GetNumberOfArgs());
   __ invoke(GetProcedure()->AsLambda(), GetNumberOfArgs());
 }
 
@@ -10,7 +10,6 @@
 #include "gel/common.h"
 #include "gel/disassembler.h"
 #include "gel/error.h"
-#include "gel/event_loop.h"
 #include "gel/expression.h"
 #include "gel/instruction.h"
 #include "gel/lambda.h"
@@ -18,6 +17,7 @@
 #include "gel/local_scope.h"
 #include "gel/macro.h"
 #include "gel/module.h"
+#include "gel/nan_box.h"
 #include "gel/namespace.h"
 #include "gel/native_procedure.h"
 #include "gel/object.h"
@@ -31,6 +31,13 @@ namespace gel {
 #define POPN(N, Result) (GetOperationStack()->PopN((Result), (N), true));
 #define PUSH(Value)     (GetOperationStack()->Push(gel::IsNull((Value)) ? Null() : (Value)))
 
+#ifdef GEL_ENABLE_NAN_BOXING
+// unboxes the Longs & Doubles pushed as Objects (e.g. loaded from a local).
+static inline auto Unbox(const NanBox& slot) -> NanBox {
+  return slot.IsObject() ? NanBox::Unbox(slot.GetObject()) : slot;
+}
+#endif  // GEL_ENABLE_NAN_BOXING
+
 auto Interpreter::GetOperationStack() -> OperationStack* {
   return runtime_->GetOperationStack();
 }
@@ -40,6 +47,9 @@ auto Interpreter::GetScope() const -> LocalScope* {
 }
 
 void Interpreter::LoadLocal(const uword idx) {
+  const auto stack = GetOperationStack();
+  if (stack->HasLocals())  // Lambda frames keep their locals in slots, see Runtime::CallWithNArgs
+    return stack->LoadLocal(idx);
   ASSERT(idx >= 0 && idx <= GetScope()->GetNumberOfLocals());
   const auto local = GetScope()->GetLocalAt(idx);
   ASSERT(local && local->HasValue());
@@ -47,6 +57,9 @@ void Interpreter::LoadLocal(const uword idx) {
 }
 
 void Interpreter::StoreLocal(const uword idx) {
+  const auto stack = GetOperationStack();
+  if (stack->HasLocals())
+    return stack->StoreLocal(idx);
   ASSERT(idx >= 0 && idx <= GetScope()->GetNumberOfLocals());
   const auto local = GetScope()->GetLocalAt(idx);
   ASSERT(local);
@@ -55,8 +68,9 @@ void Interpreter::StoreLocal(const uword idx) {
   local->SetValue((*value));
 }
 
-void Interpreter::Push(const Bytecode code) {
-  switch (code.op()) {
+template <const Bytecode::Op Op>
+void Interpreter::Push() {
+  switch (Op) {
     case Bytecode::kPushQ: {
       const auto value = NextObjectPointer();
       ASSERT(value);
@@ -64,9 +78,13 @@ void Interpreter::Push(const Bytecode code) {
       return;
     }
     case Bytecode::kPushI: {
+#ifdef GEL_ENABLE_NAN_BOXING
+      GetOperationStack()->PushSlot(NanBox::OfLong(NextUWord()));
+#else
       const auto value = NextLong();
       ASSERT(value);
       PUSH(value);
+#endif  // GEL_ENABLE_NAN_BOXING
       return;
     }
     case Bytecode::kPushN: {
@@ -88,12 +106,13 @@ void Interpreter::Push(const Bytecode code) {
       return;
     }
     default:
-      LOG(FATAL) << "invalid Push instruction: " << code;
+      LOG(FATAL) << "invalid Push instruction: " << Bytecode(Op);
   }
 }
 
-void Interpreter::Jump(const Bytecode code, const uword target) {
-  switch (code.op()) {
+template <const Bytecode::Op Op>
+void Interpreter::Jump(const uword target) {
+  switch (Op) {
     case Bytecode::kJnz: {
       const auto value = POP;
       ASSERT(value);
@@ -106,7 +125,7 @@ void Interpreter::Jump(const Bytecode code, const uword target) {
       ASSERT(rhs);
       const auto lhs = POP;
       ASSERT(lhs);
-      if (!(*lhs)->Equals((*rhs)))
+      if ((*lhs) != (*rhs) && !(*lhs)->Equals((*rhs)))
         current_ = target;
       return;
     }
@@ -114,7 +133,7 @@ void Interpreter::Jump(const Bytecode code, const uword target) {
       current_ = target;
       return;
     default:
-      LOG(FATAL) << "invalid Jump bytecode: " << code;
+      LOG(FATAL) << "invalid Jump bytecode: " << Bytecode(Op);
   }
 }
 
@@ -149,19 +168,53 @@ void Interpreter::Invoke(const Bytecode::Op op) {
   return Throw();
 }
 
+void Interpreter::TailInvoke() {
+  const auto func = NextObjectPointer();
+  ASSERT(func && func->IsLambda());
+  const auto num_args = NextUWord();
+  const auto runtime = GetRuntime();
+  // a tail call from anything but a Lambda is a regular call, the following ret returns its result
+  if (!runtime->GetCurrentStackFrame().IsLambdaFrame())
+    return runtime->CallWithNArgs(func->AsLambda(), num_args);
+  SetCurrentAddress(runtime->TailCallWithNArgs(func->AsLambda(), num_args));
+  // a loop written as tail recursion never takes a back edge, so it polls the EventLoop here instead
+  runtime->GetScheduler()->OnBackEdge();
+}
+
 void Interpreter::Throw() {
   const auto err = (*POP);
   ASSERT(err && err->IsError());
   throw std::runtime_error(err->AsError()->GetMessage()->Get());
 }
 
-void Interpreter::ExecBinaryOp(const Bytecode code) {
-  ASSERT(code.IsBinaryOp());
+template <const Bytecode::Op Op>
+void Interpreter::ExecBinaryOp() {
+  static_assert(Bytecode(Op).IsBinaryOp());
+#ifdef GEL_ENABLE_NAN_BOXING
+  const auto stack = GetOperationStack();
+  const auto rhs_slot = stack->PopSlot();
+  const auto lhs_slot = stack->PopSlot();
+  const auto rhs_number = Unbox(rhs_slot);
+  const auto lhs_number = Unbox(lhs_slot);
+  if (lhs_number.IsNumber() && rhs_number.IsNumber() && ExecNumberBinaryOp<Op>(lhs_number, rhs_number))
+    return;
+  // both operands are boxed on the stack before either is popped, boxing one may collect the other otherwise
+  stack->PushSlot(lhs_slot);
+  stack->PushSlot(rhs_slot);
+  stack->BoxTop(2);
+  const auto rhs = (*POP);
+  ASSERT(rhs);
+  const auto lhs = (*POP);
+  ASSERT(lhs);
+#else
   const auto rhs = (*POP);
   ASSERT(rhs);
   const auto lhs = (*POP);
   ASSERT(lhs);
-  switch (code.op()) {
+  if (IsSmi(lhs) && IsSmi(rhs) && ExecSmiBinaryOp<Op>(SmiValue(lhs), SmiValue(rhs)))
+    return;
+#endif  // GEL_ENABLE_NAN_BOXING
+  switch (Op) {
     case Bytecode::kAdd: {
       const auto value = lhs->Add(rhs);
       ASSERT(value);
@@ -238,15 +291,107 @@ void Interpreter::ExecBinaryOp(const Bytecode code) {
       return PUSH(value);
     }
     default:
-      LOG(FATAL) << "invalid BinaryOp: " << code;
+      LOG(FATAL) << "invalid BinaryOp: " << Bytecode(Op);
   }
 }
 
-void Interpreter::ExecUnaryOp(const Bytecode code) {
-  ASSERT(code.IsUnaryOp());
+// the operands are both Smis, so the arithmetic & comparisons are done w/o any virtual calls. returns false for the
+// ops left to the Objects (e.g. kDivide).
+template <const Bytecode::Op Op>
+auto Interpreter::ExecSmiBinaryOp(const uint64_t lhs, const uint64_t rhs) -> bool {
+  switch (Op) {
+    case Bytecode::kAdd:
+      PUSH(Long::New(lhs + rhs));
+      return true;
+    case Bytecode::kSubtract:
+      PUSH(Long::New(lhs - rhs));
+      return true;
+    case Bytecode::kMultiply:
+      PUSH(Long::New(lhs * rhs));
+      return true;
+    case Bytecode::kEquals:
+      PUSH(Bool::Box(lhs == rhs));
+      return true;
+    case Bytecode::kLessThan:
+      PUSH(Bool::Box(lhs < rhs));
+      return true;
+    case Bytecode::kLessThanEqual:
+      PUSH(Bool::Box(lhs <= rhs));
+      return true;
+    case Bytecode::kGreaterThan:
+      PUSH(Bool::Box(lhs > rhs));
+      return true;
+    case Bytecode::kGreaterThanEqual:
+      PUSH(Bool::Box(lhs >= rhs));
+      return true;
+    default:
+      return false;
+  }
+}
+
+#ifdef GEL_ENABLE_NAN_BOXING
+// the operands are both unboxed numbers, the result keeps the type of `lhs` like Long's & Double's arithmetic does.
+// returns false for the ops left to the Objects (e.g. integer kDivide).
+template <const Bytecode::Op Op>
+auto Interpreter::ExecNumberBinaryOp(const NanBox lhs, const NanBox rhs) -> bool {
+  const auto stack = GetOperationStack();
+  ASSERT(stack);
+  switch (Op) {
+    case Bytecode::kAdd:
+      stack->PushSlot(lhs.IsLong() ? NanBox::OfLong(lhs.GetLong() + rhs.AsLong())
+                                   : NanBox::OfDouble(lhs.GetDouble() + rhs.AsDouble()));
+      return true;
+    case Bytecode::kSubtract:
+      stack->PushSlot(lhs.IsLong() ? NanBox::OfLong(lhs.GetLong() - rhs.AsLong())
+                                   : NanBox::OfDouble(lhs.GetDouble() - rhs.AsDouble()));
+      return true;
+    case Bytecode::kMultiply:
+      stack->PushSlot(lhs.IsLong() ? NanBox::OfLong(lhs.GetLong() * rhs.AsLong())
+                                   : NanBox::OfDouble(lhs.GetDouble() * rhs.AsDouble()));
+      return true;
+    case Bytecode::kDivide:
+      if (lhs.IsLong())
+        return false;
+      stack->PushSlot(NanBox::OfDouble(lhs.GetDouble() / rhs.AsDouble()));
+      return true;
+    case Bytecode::kEquals:
+      // Longs & Doubles are never equal to each other
+      PUSH(Bool::Box(lhs.IsLong() == rhs.IsLong() && lhs.AsDouble() == rhs.AsDouble()));
+      return true;
+    default:
+      break;
+  }
+  const auto compare = [](const auto a, const auto b) -> int {
+    return a < b ? -1 : (a > b ? +1 : 0);
+  };
+  // compares integers as integers, anything else as doubles
+  const auto comparison = lhs.IsLong() && rhs.IsLong() ? compare(lhs.GetLong(), rhs.GetLong())
+                                                       : compare(lhs.AsDouble(), rhs.AsDouble());
+  switch (Op) {
+    case Bytecode::kLessThan:
+      PUSH(Bool::Box(comparison < 0));
+      return true;
+    case Bytecode::kLessThanEqual:
+      PUSH(Bool::Box(comparison <= 0));
+      return true;
+    case Bytecode::kGreaterThan:
+      PUSH(Bool::Box(comparison > 0));
+      return true;
+    case Bytecode::kGreaterThanEqual:
+      PUSH(Bool::Box(comparison >= 0));
+      return true;
+    default:
+      return false;
+  }
+}
+#endif  // GEL_ENABLE_NAN_BOXING
+
+template <const Bytecode::Op Op>
+void Interpreter::ExecUnaryOp() {
+  static_assert(Bytecode(Op).IsUnaryOp());
   const auto value = (*POP);
   ASSERT(value);
-  switch (code.op()) {
+  switch (Op) {
     case Bytecode::kNot: {
       const auto new_value = Bool::Box(!gel::Truth(value));
       ASSERT(new_value);
@@ -278,7 +423,7 @@ void Interpreter::ExecUnaryOp(const Bytecode code) {
       return;
     }
     default:
-      LOG(FATAL) << "invalid UnaryOp: " << code;
+      LOG(FATAL) << "invalid UnaryOp: " << Bytecode(Op);
   }
 }
 
@@ -345,121 +490,80 @@ void Interpreter::New(Class* cls, const uword num_args) {
   ASSERT(cls);
   ObjectList args{};
   POPN(num_args, args);
+  Runtime::ArgumentsScope arguments(runtime_, args);
   const auto value = cls->NewInstance(args);
   ASSERT(value);
   PUSH(value);
 }
 
+#if defined(GEL_ENABLE_THREADED_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#define GEL_THREADED_DISPATCH
+#endif
+
+DEFINE_bool(threaded_dispatch, true, "Dispatch bytecodes w/ computed gotos, when the interpreter was built w/ them.");
+
 void Interpreter::Run(const uword address) {
+#ifdef GEL_THREADED_DISPATCH
+  if (FLAGS_threaded_dispatch)
+    return RunThreaded(address);
+#endif  // GEL_THREADED_DISPATCH
+  return RunSwitch(address);
+}
+
+#ifdef GEL_THREADED_DISPATCH
+// every handler decodes & jumps to the next handler itself, so each handler gets its own indirect branch to predict.
+#define TARGET(Name) L_##Name:
+#define DISPATCH()                                  \
+  do {                                              \
+    start_address = GetCurrentAddress();            \
+    op = NextBytecode();                            \
+    ASSERT(op.raw() < Bytecode::kTotalNumberOfOps); \
+    goto* kDispatchTable[op.raw()];                 \
+  } while (false)
+
+void Interpreter::RunThreaded(const uword address) {
   SetCurrentAddress(address);
   ASSERT(GetCurrentAddress() == address);
+  uword start_address = address;
+  Bytecode op{};
+  static const void* kDispatchTable[] = {
+      &&L_Invalid,
+#define DEFINE_TARGET_ADDRESS(Name) &&L_##Name,
+      FOR_EACH_BYTECODE(DEFINE_TARGET_ADDRESS)
+#undef DEFINE_TARGET_ADDRESS
+  };
+  static_assert((sizeof(kDispatchTable) / sizeof(kDispatchTable[0])) == Bytecode::kTotalNumberOfOps);
+  DISPATCH();
+#include "gel/interpreter_dispatch.h"
+L_Invalid:
+  LOG(FATAL) << "invalid op: " << op;
+}
+
+#undef TARGET
+#undef DISPATCH
+#endif  // GEL_THREADED_DISPATCH
+
+#define TARGET(Name) case Bytecode::k##Name:
+#define DISPATCH()   continue
+
+void Interpreter::RunSwitch(const uword address) {
+  SetCurrentAddress(address);
+  ASSERT(GetCurrentAddress() == address);
+  uword start_address = address;
+  Bytecode op{};
   while (true) {
-    const auto start_address = GetCurrentAddress();
-    const auto pos = (start_address - address);
-    const auto op = NextBytecode();
+    start_address = GetCurrentAddress();
+    op = NextBytecode();
     switch (op.op()) {
-      case Bytecode::kPushN:
-      case Bytecode::kPushT:
-      case Bytecode::kPushF:
-      case Bytecode::kPushI:
-      case Bytecode::kPushQ:
-        Push(op);
-        continue;
-      case Bytecode::kPop:
-        Pop();
-        continue;
-      case Bytecode::kDup:
-        Dup();
-        continue;
-      case Bytecode::kLookup:
-        PopLookup();
-        continue;
-      case Bytecode::kLoadLocal:
-        LoadLocal(NextUWord());
-        continue;
-      case Bytecode::kLoadLocal0:
-      case Bytecode::kLoadLocal1:
-      case Bytecode::kLoadLocal2:
-      case Bytecode::kLoadLocal3: {
-        const auto idx = op - Bytecode::kLoadLocal0;
-        LoadLocal(idx);
-        continue;
-      }
-      case Bytecode::kStoreLocal:
-        StoreLocal(NextUWord());
-        continue;
-      case Bytecode::kStoreLocal0:
-      case Bytecode::kStoreLocal1:
-      case Bytecode::kStoreLocal2:
-      case Bytecode::kStoreLocal3:
-        StoreLocal(op - Bytecode::kStoreLocal0);
-        continue;
-      case Bytecode::kInvoke:
-      case Bytecode::kInvokeNative:
-      case Bytecode::kInvokeDynamic:
-        Invoke(op.op());
-        continue;
-      case Bytecode::kThrow:
-        return Throw();
-      case Bytecode::kCheckInstance: {
-        const auto cls = NextObjectPointer();
-        ASSERT(cls && cls->IsClass());
-        CheckInstance(cls->AsClass());
-        continue;
-      }
-      case Bytecode::kCast: {
-        const auto cls = NextObjectPointer();
-        ASSERT(cls && cls->IsClass());
-        Cast(cls->AsClass());
-        continue;
-      }
-      case Bytecode::kNop:
-        nop();
-        continue;
-        // clang-format off
-#define DECLARE_CASE(Name) \
-  case Bytecode::k##Name:
-      FOR_EACH_BINARY_OP(DECLARE_CASE)
-        // clang-format on
-        ExecBinaryOp(op);
-        continue;
-        // clang-format off
-      FOR_EACH_UNARY_OP(DECLARE_CASE)
-        // clang-format on
-        ExecUnaryOp(op);
-        continue;
-#undef DECLARE_CASE
-      case Bytecode::kRet: {
-        const auto event_loop = GetThreadEventLoop();
-        ASSERT(event_loop);
-        while (event_loop->Run(UV_RUN_NOWAIT) != 0);  // do nothing
-        return;
-      }
-      case Bytecode::kJump:
-      case Bytecode::kJz:
-      case Bytecode::kJnz:
-      case Bytecode::kJeq:
-      case Bytecode::kJne: {
-        const auto offset = NextWord();
-        Jump(op, address + (pos + offset));
-        continue;
-      }
-      case Bytecode::kStoreField:
-        StoreField(NextField());
-        continue;
-      case Bytecode::kLoadField:
-        LoadField(NextField());
-        continue;
-      case Bytecode::kNew: {
-        const auto cls = NextClass();
-        ASSERT(cls);
-        New(cls, NextUWord());
-        continue;
-      }
+#include "gel/interpreter_dispatch.h"
       case Bytecode::kInvalid:
       default:
         LOG(FATAL) << "invalid op: " << op;
+        return;
     }
   }
 }
-}  // namespace gel
\ No newline at end of file
+
+#undef TARGET
+#undef DISPATCH
+}  // namespace gel
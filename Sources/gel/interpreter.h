@@ -5,8 +5,10 @@
 
 #include "gel/bytecode.h"
 #include "gel/common.h"
+#include "gel/flags.h"
 #include "gel/instruction.h"
 #include "gel/local_scope.h"
+#include "gel/nan_box.h"
 #include "gel/platform.h"
 #include "gel/section.h"
 #include "gel/stack_frame.h"
@@ -14,9 +16,12 @@
 #include "gel/type_traits.h"
 
 namespace gel {
+DECLARE_bool(threaded_dispatch);
+
 class Runtime;
 class Interpreter {
   friend class Runtime;
+  friend class AllocationProfiler;
   DEFINE_NON_COPYABLE_TYPE(Interpreter);
 
  private:
@@ -78,15 +83,29 @@ class Interpreter {
   void LoadField(Field* field);
   void StoreField(Field* field);
   void Invoke(const Bytecode::Op op);
-  void Push(const Bytecode code);
+  void TailInvoke();
+  template <const Bytecode::Op Op>
+  void Push();
   void LoadLocal(const uword idx);
   void StoreLocal(const uword idx);
-  void ExecUnaryOp(const Bytecode code);
-  void ExecBinaryOp(const Bytecode code);
+  template <const Bytecode::Op Op>
+  void ExecUnaryOp();
+  template <const Bytecode::Op Op>
+  void ExecBinaryOp();
+  template <const Bytecode::Op Op>
+  auto ExecSmiBinaryOp(const uint64_t lhs, const uint64_t rhs) -> bool;
+#ifdef GEL_ENABLE_NAN_BOXING
+  template <const Bytecode::Op Op>
+  auto ExecNumberBinaryOp(const NanBox lhs, const NanBox rhs) -> bool;
+#endif  // GEL_ENABLE_NAN_BOXING
   void New(Class* cls, const uword num_args);
   void Cast(Class* cls);
   void CheckInstance(Class* cls);
-  void Jump(const Bytecode code, const uword address);
+  template <const Bytecode::Op Op>
+  void Jump(const uword target);
+  // the dispatch loops of Run, see --threaded_dispatch.
+  void RunThreaded(const uword address);
+  void RunSwitch(const uword address);
 
  protected:
   explicit Interpreter(Runtime* runtime) :
@@ -0,0 +1,155 @@
+// the bytecode handlers of Interpreter::Run, included by each dispatch loop (so there's no include guard). a loop defines
+// TARGET(Name) to label a handler & DISPATCH() to continue w/ the next bytecode, see interpreter.cc.
+      TARGET(PushN) {
+        Push<Bytecode::kPushN>();
+        DISPATCH();
+      }
+      TARGET(PushT) {
+        Push<Bytecode::kPushT>();
+        DISPATCH();
+      }
+      TARGET(PushF) {
+        Push<Bytecode::kPushF>();
+        DISPATCH();
+      }
+      TARGET(PushI) {
+        Push<Bytecode::kPushI>();
+        DISPATCH();
+      }
+      TARGET(PushQ) {
+        Push<Bytecode::kPushQ>();
+        DISPATCH();
+      }
+      TARGET(Pop) {
+        Pop();
+        DISPATCH();
+      }
+      TARGET(Dup) {
+        Dup();
+        DISPATCH();
+      }
+      TARGET(Lookup) {
+        PopLookup();
+        DISPATCH();
+      }
+      TARGET(LoadLocal) {
+        LoadLocal(NextUWord());
+        DISPATCH();
+      }
+      TARGET(LoadLocal0) {
+        LoadLocal(0);
+        DISPATCH();
+      }
+      TARGET(LoadLocal1) {
+        LoadLocal(1);
+        DISPATCH();
+      }
+      TARGET(LoadLocal2) {
+        LoadLocal(2);
+        DISPATCH();
+      }
+      TARGET(LoadLocal3) {
+        LoadLocal(3);
+        DISPATCH();
+      }
+      TARGET(StoreLocal) {
+        StoreLocal(NextUWord());
+        DISPATCH();
+      }
+      TARGET(StoreLocal0) {
+        StoreLocal(0);
+        DISPATCH();
+      }
+      TARGET(StoreLocal1) {
+        StoreLocal(1);
+        DISPATCH();
+      }
+      TARGET(StoreLocal2) {
+        StoreLocal(2);
+        DISPATCH();
+      }
+      TARGET(StoreLocal3) {
+        StoreLocal(3);
+        DISPATCH();
+      }
+      TARGET(Invoke) {
+        Invoke(Bytecode::kInvoke);
+        DISPATCH();
+      }
+      TARGET(InvokeNative) {
+        Invoke(Bytecode::kInvokeNative);
+        DISPATCH();
+      }
+      TARGET(TailInvoke) {
+        TailInvoke();
+        DISPATCH();
+      }
+      TARGET(InvokeDynamic) {
+        Invoke(Bytecode::kInvokeDynamic);
+        DISPATCH();
+      }
+      TARGET(Throw) {
+        return Throw();
+      }
+      TARGET(CheckInstance) {
+        const auto cls = NextObjectPointer();
+        ASSERT(cls && cls->IsClass());
+        CheckInstance(cls->AsClass());
+        DISPATCH();
+      }
+      TARGET(Cast) {
+        const auto cls = NextObjectPointer();
+        ASSERT(cls && cls->IsClass());
+        Cast(cls->AsClass());
+        DISPATCH();
+      }
+      TARGET(Nop) {
+        nop();
+        DISPATCH();
+      }
+#define DEFINE_BINARY_OP_TARGET(Name)  \
+  TARGET(Name) {                       \
+    ExecBinaryOp<Bytecode::k##Name>(); \
+    DISPATCH();                        \
+  }
+      FOR_EACH_BINARY_OP(DEFINE_BINARY_OP_TARGET)
+#undef DEFINE_BINARY_OP_TARGET
+#define DEFINE_UNARY_OP_TARGET(Name)  \
+  TARGET(Name) {                      \
+    ExecUnaryOp<Bytecode::k##Name>(); \
+    DISPATCH();                       \
+  }
+      FOR_EACH_UNARY_OP(DEFINE_UNARY_OP_TARGET)
+#undef DEFINE_UNARY_OP_TARGET
+      TARGET(Ret) {
+        return;
+      }
+      // the offset of a jump is relative to the start of its bytecode, taking a backward jump is a safepoint
+#define DEFINE_JUMP_TARGET(Name)                       \
+  TARGET(Name) {                                       \
+    const auto offset = NextWord();                    \
+    Jump<Bytecode::k##Name>(start_address + offset);   \
+    if (GetCurrentAddress() <= start_address)          \
+      runtime_->GetScheduler()->OnBackEdge();          \
+    DISPATCH();                                        \
+  }
+      DEFINE_JUMP_TARGET(Jump)
+      DEFINE_JUMP_TARGET(Jz)
+      DEFINE_JUMP_TARGET(Jnz)
+      DEFINE_JUMP_TARGET(Jeq)
+      DEFINE_JUMP_TARGET(Jne)
+#undef DEFINE_JUMP_TARGET
+      TARGET(StoreField) {
+        StoreField(NextField());
+        DISPATCH();
+      }
+      TARGET(LoadField) {
+        LoadField(NextField());
+        DISPATCH();
+      }
+      TARGET(New) {
+        const auto cls = NextClass();
+        ASSERT(cls);
+        New(cls, NextUWord());
+        DISPATCH();
+      }
@@ -36,6 +36,23 @@ auto Lambda::VisitPointers(PointerVisitor* vis) -> bool {
   return false;
 }
 
+auto Lambda::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  if (!Procedure::VisitPointers(vis) || !VisitPointer(vis, &owner_) || !VisitPointer(vis, &docstring_))
+    return false;
+  // the body is still needed to compile the Lambda on its first call
+  for (auto& expr : (*body_)) {
+    if (!VisitPointer(vis, &expr))
+      return false;
+  }
+  // the parent scopes are visited by their owners
+  return !HasScope() || GetScope()->VisitLocalPointers(
+                            [vis](Pointer** ptr) {
+                              return vis->Visit(ptr);
+                            },
+                            false);
+}
+
 auto Lambda::New(const ObjectList& args) -> Lambda* {
   NOT_IMPLEMENTED(FATAL);
 }
@@ -34,36 +34,37 @@ class Lambda : public Procedure, public Executable {
   Object* owner_ = nullptr;
   String* docstring_ = nullptr;
   LocalScope* scope_ = nullptr;
-  ArgumentSet args_;           // TODO: fails to copy during GC
-  expr::ExpressionList body_;  // TODO: fails to copy during GC
+  uword num_locals_ = 0;  // the size of the Lambda's slot window, resolved by the FlowGraphCompiler
+  std::unique_ptr<ArgumentSet> args_;           // off-heap, see Object::RegisterFinalizer
+  std::unique_ptr<expr::ExpressionList> body_;  // off-heap, the Expressions are visited by the collector
 
   inline auto at(const uint64_t idx) const -> expr::ExpressionList::const_iterator {
-    return std::begin(body_) + static_cast<expr::ExpressionList::difference_type>(idx);
+    return std::begin(GetBody()) + static_cast<expr::ExpressionList::difference_type>(idx);
   }
 
   inline void Append(expr::Expression* expr) {
     ASSERT(expr);
-    body_.push_back(expr);
+    body_->push_back(expr);
   }
 
   inline void InsertAt(const uint64_t idx, expr::Expression* expr) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
     ASSERT(expr);
-    body_.insert(at(idx), expr);
+    body_->insert(at(idx), expr);
   }
 
   inline void InsertAt(const uint64_t idx, const expr::ExpressionList& exprs) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
     ASSERT(!exprs.empty());
-    body_.insert(at(idx), std::begin(exprs), std::end(exprs));
+    body_->insert(at(idx), std::begin(exprs), std::end(exprs));
   }
 
   void SetArgs(const ArgumentSet& args) {
-    args_ = args;
+    (*args_) = args;
   }
 
   void SetBody(const expr::ExpressionList& body) {
-    body_ = body;
+    (*body_) = body;
   }
 
   inline void SetBody(expr::Expression* expr) {
@@ -71,20 +72,22 @@ class Lambda : public Procedure, public Executable {
     return SetBody(expr::ExpressionList{expr});
   }
 
-  void SetScope(LocalScope* scope) {
-    ASSERT(scope);
-    scope_ = scope;
+  void SetNumberOfLocals(const uword num_locals) {
+    ASSERT(num_locals > GetNumberOfArgs());
+    num_locals_ = num_locals;
   }
 
   void SetExpressionAt(const uint64_t idx, expr::Expression* expr) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
     ASSERT(expr);
-    body_[idx] = expr;
+    PreWriteBarrier((*body_)[idx]);
+    (*body_)[idx] = expr;
   }
 
   void RemoveExpressionAt(const uint64_t idx) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
-    body_.erase(at(idx));
+    PreWriteBarrier((*body_)[idx]);
+    body_->erase(at(idx));
   }
 
   void ReplaceExpressionAt(const uint64_t idx, expr::Expression* expr) {
@@ -102,16 +105,23 @@ class Lambda : public Procedure, public Executable {
   }
 
  protected:
-  Lambda(Symbol* symbol, ArgumentSet args, const expr::ExpressionList& body) :  // NOLINT(modernize-pass-by-value)
+  Lambda(Symbol* symbol, const ArgumentSet& args, const expr::ExpressionList& body) :
     Procedure(symbol),
-    args_(args),
-    body_(body) {}
+    args_(std::make_unique<ArgumentSet>(args)),
+    body_(std::make_unique<expr::ExpressionList>(body)) {
+    RegisterFinalizer();
+  }
 
   auto VisitPointers(PointerVisitor* vis) -> bool override;
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
  public:
   ~Lambda() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto GetOwner() const -> Object* {
     return owner_;
   }
@@ -139,34 +149,44 @@ class Lambda : public Procedure, public Executable {
   }
 
   auto GetArgs() const -> const ArgumentSet& {
-    return args_;
+    return (*args_);
   }
 
   auto GetBody() const -> const expr::ExpressionList& {
-    return body_;
+    return (*body_);
   }
 
   auto GetNumberOfExpressions() const -> uint64_t {
-    return body_.size();
+    return GetBody().size();
   }
 
   inline auto IsEmpty() const -> bool {
-    return body_.empty();
+    return GetBody().empty();
   }
 
   auto GetExpressionAt(const uint64_t idx) const -> expr::Expression* {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
-    return body_[idx];
+    return GetBody()[idx];
   }
 
   auto GetNumberOfArgs() const -> uint64_t {
-    return args_.size();
+    return GetArgs().size();
+  }
+
+  // the Lambda itself, its arguments & the rest of its locals, see Runtime::CallWithNArgs.
+  auto GetNumberOfLocals() const -> uword {
+    return num_locals_;
   }
 
   auto GetScope() const -> LocalScope* {  // TODO: this should never return nullptr
     return scope_;
   }
 
+  void SetScope(LocalScope* scope) {
+    ASSERT(scope);
+    scope_ = scope;
+  }
+
   inline auto HasScope() const -> bool {
     return GetScope() != nullptr;
   }
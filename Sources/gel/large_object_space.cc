@@ -0,0 +1,107 @@
+#include "gel/large_object_space.h"
+
+#include <algorithm>
+
+#include "gel/common.h"
+#include "gel/memory_region.h"
+
+namespace gel {
+LargeObjectSpace::LargeObjectSpace(const uword max_size) :
+  Region(MemoryRegion(RoundUp(max_size, MemoryRegion::GetPageSize()), MemoryRegion::kNoAccess)),
+  limit_(GetOldZoneSize()) {
+  free_runs_.emplace(GetStartingAddress(), GetSize());
+}
+
+auto LargeObjectSpace::TryAllocateRun(const uword size) -> uword {
+  ASSERT(size > 0 && (size % MemoryRegion::GetPageSize()) == 0);
+  const auto run = std::find_if(free_runs_.begin(), free_runs_.end(), [size](const auto& rhs) {
+    return rhs.second >= size;
+  });
+  if (run == free_runs_.end())
+    return UNALLOCATED;
+  const auto start = run->first;
+  const auto remaining = run->second - size;
+  free_runs_.erase(run);
+  if (remaining > 0)
+    free_runs_.emplace(start + size, remaining);
+  MemoryRegion(*this).Protect(start - GetStartingAddress(), size, MemoryRegion::kReadWrite);
+  return start;
+}
+
+void LargeObjectSpace::FreeRun(const uword start, const uword size) {
+  ASSERT(start >= GetStartingAddress() && (start + size) <= GetEndingAddress());
+  MemoryRegion region(*this);
+  region.Release(start - GetStartingAddress(), size);
+  region.Protect(start - GetStartingAddress(), size, MemoryRegion::kNoAccess);
+  auto run_start = start;
+  auto run_size = size;
+  // merge w/ the neighbouring runs so the reservation doesn't fragment into single pages
+  const auto next = free_runs_.lower_bound(start);
+  if (next != free_runs_.end() && next->first == (start + size)) {
+    run_size += next->second;
+    free_runs_.erase(next);
+  }
+  const auto prev = free_runs_.lower_bound(start);
+  if (prev != free_runs_.begin()) {
+    const auto run = std::prev(prev);
+    if ((run->first + run->second) == start) {
+      run_start = run->first;
+      run_size += run->second;
+      free_runs_.erase(run);
+    }
+  }
+  free_runs_.emplace(run_start, run_size);
+}
+
+auto LargeObjectSpace::TryAllocate(const uword size) -> uword {
+  ASSERT(size > 0);
+  const auto total_size = RoundUp(sizeof(Pointer) + size, MemoryRegion::GetPageSize());
+  const auto start = TryAllocateRun(total_size);
+  if (start == UNALLOCATED)
+    return UNALLOCATED;
+  const auto ptr = Pointer::New(start, Tag::Old(total_size - sizeof(Pointer)));
+  ASSERT(ptr);
+  objects_.push_back(ptr);
+  allocated_ += total_size;
+  return ptr->GetObjectAddress();
+}
+
+void LargeObjectSpace::Free(Pointer* ptr) {
+  ASSERT(ptr && Contains(ptr->GetStartingAddress()));
+  const auto total_size = ptr->GetTotalSize();
+  allocated_ -= total_size;
+  FreeRun(ptr->GetStartingAddress(), total_size);
+}
+
+auto LargeObjectSpace::Sweep() -> uword {
+  uword num_freed = 0;
+  uword bytes_freed = 0;
+  objects_.erase(std::remove_if(objects_.begin(), objects_.end(),
+                                [&](Pointer* ptr) {
+                                  if (ptr->GetTag().IsMarked()) {
+                                    ptr->tag().ClearMarkedBit();
+                                    return false;
+                                  }
+                                  num_freed += 1;
+                                  bytes_freed += ptr->GetTotalSize();
+                                  Free(ptr);
+                                  return true;
+                                }),
+                 objects_.end());
+  limit_ = std::max(GetOldZoneSize(), GetNumberOfBytesAllocated() * 2);
+  DVLOG(1) << "swept " << num_freed << " large pointers (" << units::data::byte_t(static_cast<double>(bytes_freed))
+           << ") from: " << (*this);
+  return bytes_freed;
+}
+
+auto LargeObjectSpace::VisitPointers(const std::function<bool(Pointer*)>& vis) const -> bool {
+  return std::all_of(objects_.begin(), objects_.end(), vis);
+}
+
+void LargeObjectSpace::Clear() {
+  for (const auto& ptr : objects_)
+    Free(ptr);
+  objects_.clear();
+  limit_ = GetOldZoneSize();
+}
+}  // namespace gel
@@ -0,0 +1,69 @@
+#ifndef GEL_LARGE_OBJECT_SPACE_H
+#define GEL_LARGE_OBJECT_SPACE_H
+
+#include <units.h>
+
+#include <functional>
+#include <map>
+
+#include "gel/common.h"
+#include "gel/pointer.h"
+#include "gel/section.h"
+#include "gel/zone.h"
+
+namespace gel {
+// holds the objects >= kLargeObjectSize, each in its own run of pages carved from a reserved range of address space.
+// large objects are never copied, they're marked in place & their pages are handed back to the OS once unmarked.
+class LargeObjectSpace : public Region {
+  friend class Heap;
+  DEFINE_NON_COPYABLE_TYPE(LargeObjectSpace);
+
+ private:
+  std::map<uword, uword> free_runs_{};  // the unused runs of pages in the reservation, by starting address
+  PointerList objects_{};               // every large object allocated, in allocation order
+  uword allocated_ = 0;
+  uword limit_ = 0;  // the number of bytes allocated that should trigger a collection
+
+  auto TryAllocateRun(const uword size) -> uword;
+  void FreeRun(const uword start, const uword size);
+
+ protected:
+  void Clear() override;
+
+ public:
+  explicit LargeObjectSpace(const uword max_size = GetMaxHeapSize());
+  ~LargeObjectSpace() override = default;
+
+  auto GetNumberOfObjects() const -> uword {
+    return objects_.size();
+  }
+
+  auto GetNumberOfBytesAllocated() const -> uword {
+    return allocated_;
+  }
+
+  auto ShouldCollect() const -> bool {
+    return GetNumberOfBytesAllocated() >= limit_;
+  }
+
+  // commits a page aligned run for an object of `size` bytes, returns the address of the object.
+  auto TryAllocate(const uword size) -> uword;
+  // decommits the pages of `ptr` & returns them to the reservation.
+  void Free(Pointer* ptr);
+  // frees every unmarked large object & clears the marked bit of the survivors, returns the number of bytes freed.
+  auto Sweep() -> uword;
+  auto VisitPointers(const std::function<bool(Pointer*)>& vis) const -> bool;
+
+  friend auto operator<<(std::ostream& stream, const LargeObjectSpace& rhs) -> std::ostream& {
+    using namespace units::data;
+    stream << "LargeObjectSpace(";
+    stream << "start=" << rhs.GetStartingAddressPointer() << ", ";
+    stream << "objects=" << rhs.GetNumberOfObjects() << ", ";
+    stream << "allocated=" << byte_t(static_cast<double>(rhs.GetNumberOfBytesAllocated()));
+    stream << ")";
+    return stream;
+  }
+};
+}  // namespace gel
+
+#endif  // GEL_LARGE_OBJECT_SPACE_H
@@ -22,7 +22,9 @@ auto LocalVariable::GetValue() const -> Object* {
 
 void LocalVariable::SetValue(Object* rhs) {
   ASSERT(rhs);
+  PreWriteBarrier(value_);
   value_ = rhs->raw_ptr();
+  WriteBarrier(&value_);
 }
 
 auto LocalVariable::IsGlobal() const -> bool {
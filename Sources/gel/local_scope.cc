@@ -143,7 +143,7 @@ auto LocalScope::VisitLocalPointers(const std::function<bool(Pointer**)>& vis, c
   do {
     for (const auto& local : scope->locals_) {
       ASSERT(local);
-      if (!local->Accept(vis))
+      if (ShouldVisit(local) && !local->Accept(vis))
         return false;
     }
     scope = scope->GetParent();
@@ -169,7 +169,7 @@ auto LocalScope::Accept(PointerPointerVisitor* vis) -> bool {
   auto scope = this;
   while (scope) {
     for (const auto& local : scope->locals_) {
-      if (!local->Accept(vis))
+      if (ShouldVisit(local) && !local->Accept(vis))
         return false;
     }
     scope = scope->GetParent();
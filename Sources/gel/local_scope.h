@@ -1,6 +1,8 @@
 #ifndef GEL_LOCAL_SCOPE_H
 #define GEL_LOCAL_SCOPE_H
 
+#include <unordered_set>
+
 #include "gel/common.h"
 #include "gel/local.h"
 #include "gel/pointer.h"
@@ -92,10 +94,35 @@ class LocalScope {
     auto Next() -> LocalVariable* override;
   };
 
+  // while alive, Accept & VisitLocalPointers visit each LocalVariable at most once. the Compactor can't forward a slot
+  // twice, but a LocalVariable shared by several scopes (or a scope shared by several Lambdas) is reached through each.
+  class VisitOnceScope {
+    DEFINE_NON_COPYABLE_TYPE(VisitOnceScope);
+
+   private:
+    std::unordered_set<const LocalVariable*> visited_{};
+    std::unordered_set<const LocalVariable*>* previous_;
+
+   public:
+    VisitOnceScope() :
+      previous_(LocalScope::visited_) {
+      LocalScope::visited_ = &visited_;
+    }
+    ~VisitOnceScope() {
+      LocalScope::visited_ = previous_;
+    }
+  };
+
  private:
+  static inline thread_local std::unordered_set<const LocalVariable*>* visited_ = nullptr;  // see VisitOnceScope
+
   LocalScope* parent_;
   std::vector<LocalVariable*> locals_;
 
+  static inline auto ShouldVisit(const LocalVariable* local) -> bool {
+    return !visited_ || visited_->insert(local).second;
+  }
+
  protected:
   explicit LocalScope(LocalScope* parent = nullptr, const LocalList& locals = {}) :  // NOLINT(modernize-pass-by-value)
     parent_(parent),
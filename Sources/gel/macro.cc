@@ -31,6 +31,22 @@ auto Macro::Equals(Object* rhs) const -> bool {
   return GetSymbol()->Equals(other->GetSymbol());
 }
 
+auto Macro::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  if (!VisitPointer(vis, &owner_) || !VisitPointer(vis, &symbol_) || !VisitPointer(vis, &docstring_))
+    return false;
+  for (auto& expr : (*body_)) {
+    if (!VisitPointer(vis, &expr))
+      return false;
+  }
+  // the parent scopes are visited by their owners
+  return !scope_ || scope_->VisitLocalPointers(
+                        [vis](Pointer** ptr) {
+                          return vis->Visit(ptr);
+                        },
+                        false);
+}
+
 auto Macro::ToString() const -> std::string {
   ToStringHelper<Macro> helper;
   helper.AddField("symbol", GetSymbol()->GetFullyQualifiedName());
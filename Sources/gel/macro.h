@@ -18,16 +18,15 @@ class Macro : public Object {
   Symbol* symbol_ = nullptr;
   String* docstring_ = nullptr;
   LocalScope* scope_ = nullptr;
-  ArgumentSet args_{};
-  expr::ExpressionList body_{};
+  std::unique_ptr<ArgumentSet> args_;           // off-heap, see Object::RegisterFinalizer
+  std::unique_ptr<expr::ExpressionList> body_;  // off-heap, the Expressions are visited by the collector
 
  protected:
-  Macro() = default;
-  Macro(Symbol* symbol, const ArgumentSet& args, const expr::ExpressionList& body) :  // NOLINT(modernize-pass-by-value)
+  Macro(Symbol* symbol = nullptr, const ArgumentSet& args = {}, const expr::ExpressionList& body = {}) :
     symbol_(symbol),
-    args_(args),
-    body_(body) {
-    ASSERT(symbol);
+    args_(std::make_unique<ArgumentSet>(args)),
+    body_(std::make_unique<expr::ExpressionList>(body)) {
+    RegisterFinalizer();
   }
 
   void SetSymbol(Symbol* rhs) {
@@ -46,11 +45,11 @@ class Macro : public Object {
   }
 
   void SetArgs(const ArgumentSet& rhs) {
-    args_ = rhs;
+    (*args_) = rhs;
   }
 
   void SetBody(const expr::ExpressionList& rhs) {
-    body_ = rhs;
+    (*body_) = rhs;
   }
 
   void SetDocstring(String* rhs) {
@@ -58,9 +57,15 @@ class Macro : public Object {
     docstring_ = rhs;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~Macro() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto GetOwner() const -> Object* {
     return owner_;
   }
@@ -82,23 +87,23 @@ class Macro : public Object {
   }
 
   auto GetArgs() const -> const ArgumentSet& {
-    return args_;
+    return (*args_);
   }
 
   auto GetNumberOfArgs() const -> uint64_t {
-    return args_.size();
+    return GetArgs().size();
   }
 
   inline auto HasArgs() const -> bool {
-    return !args_.empty();
+    return !GetArgs().empty();
   }
 
   auto GetBody() const -> const expr::ExpressionList& {
-    return body_;
+    return (*body_);
   }
 
   inline auto IsEmpty() const -> bool {
-    return body_.empty();
+    return GetBody().empty();
   }
 
   DECLARE_TYPE(Macro);
@@ -110,6 +115,7 @@ class Macro : public Object {
 
  public:
   static inline auto New(Symbol* symbol, const ArgumentSet& args = {}, const expr::ExpressionList& body = {}) -> Macro* {
+    ASSERT(symbol);
     return new Macro(symbol, args, body);
   }
 };
@@ -1,3 +1,276 @@
 #include "gel/marker.h"
 
-namespace gel {}
\ No newline at end of file
+#include "gel/collector.h"
+#include "gel/heap.h"
+#include "gel/object.h"
+#include "gel/zone.h"
+
+namespace gel {
+auto Marker::IsHeapPointer(Pointer* ptr) const -> bool {
+  const auto address = ptr->GetStartingAddress();
+  const auto& new_zone = heap().GetNewZone();
+  if (address >= new_zone.fromspace() && address < (new_zone.fromspace() + new_zone.semisize()))
+    return true;
+  const auto& old_zone = heap().GetOldZone();
+  if (address >= old_zone.GetStartingAddress() && address < old_zone.GetEndingAddress())
+    return true;
+  const auto& large_object_space = heap().GetLargeObjectSpace();
+  return address >= large_object_space.GetStartingAddress() && address < large_object_space.GetEndingAddress();
+}
+
+auto Marker::Visit(Pointer** ptr) -> bool {
+  ASSERT(ptr);
+  const auto next = (*ptr);
+  if (IsUnallocated(next) || !IsHeapPointer(next))
+    return true;
+  if (next->GetTag().IsMarked())
+    return true;
+  next->tag().SetMarkedBit();
+  num_marked_ += 1;
+  bytes_marked_ += next->GetTotalSize();
+  work_.push_back(next);
+  return true;
+}
+
+auto Marker::ProcessMarkingStack() -> bool {
+  while (!work_.empty()) {
+    const auto next = work_.back();
+    work_.pop_back();
+    ASSERT(next && next->GetTag().IsMarked());
+    if (!next->VisitPointers(this))
+      return false;
+  }
+  return true;
+}
+
+auto Marker::MarkEphemerons() -> bool {
+  const auto num_marked = GetNumberOfPointersMarked();
+  const auto is_alive = [this](Pointer** ptr) {
+    return !IsHeapPointer(*ptr) || (*ptr)->GetTag().IsMarked();
+  };
+  for (const auto& ptr : heap().weak_) {
+    if (ptr->GetTag().IsMarked())
+      LOG_IF(FATAL, !ptr->VisitEphemerons(is_alive, this)) << "failed to visit ephemerons of: " << (*ptr);
+  }
+  return GetNumberOfPointersMarked() != num_marked;
+}
+
+void Marker::MarkAll() {
+  DVLOG(1) << "marking roots....";
+  LOG_IF(FATAL, !VisitRoots(this)) << "failed to visit roots.";
+  do {
+    LOG_IF(FATAL, !ProcessMarkingStack()) << "failed to process marking stack.";
+  } while (MarkEphemerons());
+  DVLOG(1) << "marked " << GetNumberOfPointersMarked() << " pointers ("
+           << units::data::byte_t(static_cast<double>(GetNumberOfBytesMarked())) << ").";
+}
+
+void Marker::ClearMarks() {
+  NewZone::Iterator iter(heap().GetNewZone());
+  while (iter.HasNext()) {
+    const auto next = iter.Next();
+    ASSERT(next);
+    next->tag().ClearMarkedBit();
+  }
+}
+
+DEFINE_uword(concurrent_mark_threshold, 50,
+             "The old zone occupancy (in percent) that starts a concurrent marking cycle, 0 disables concurrent marking.");
+
+ConcurrentMarker::~ConcurrentMarker() {
+  Stop();
+}
+
+auto ConcurrentMarker::IsOldPointer(Pointer* ptr) const -> bool {
+  const auto& old_zone = heap().GetOldZone();
+  if (ptr->GetStartingAddress() >= old_zone.GetStartingAddress() &&
+      ptr->GetStartingAddress() < old_zone.GetEndingAddress())
+    return true;
+  // the LargeObjectSpace's reservation never moves, so this is safe to check from the marker thread
+  const auto& large_object_space = heap().GetLargeObjectSpace();
+  return ptr->GetStartingAddress() >= large_object_space.GetStartingAddress() &&
+         ptr->GetStartingAddress() < large_object_space.GetEndingAddress();
+}
+
+auto ConcurrentMarker::IsNewPointer(Pointer* ptr) const -> bool {
+  const auto& new_zone = heap().GetNewZone();
+  return ptr->GetStartingAddress() >= new_zone.fromspace() &&
+         ptr->GetStartingAddress() < (new_zone.fromspace() + new_zone.semisize());
+}
+
+void ConcurrentMarker::Mark(Pointer* ptr) {
+  ASSERT(ptr && IsOldPointer(ptr));
+  if (!ptr->tag().TrySetMarkedBit())
+    return;
+  num_marked_ += 1;
+  bytes_marked_ += ptr->GetTotalSize();
+  if (!paused_ && ptr->GetObjectPointer()->HasOffHeapPointers()) {
+    deferred_.push_back(ptr);
+    return;
+  }
+  work_.push_back(ptr);
+}
+
+auto ConcurrentMarker::Visit(Pointer** ptr) -> bool {
+  ASSERT(ptr);
+  const auto next = (*ptr);
+  if (IsUnallocated(next))
+    return true;
+  if (IsOldPointer(next)) {
+    Mark(next);
+  } else if (paused_ && IsNewPointer(next) && !next->GetTag().IsMarked()) {
+    next->tag().SetMarkedBit();
+    young_.push_back(next);
+  }
+  return true;
+}
+
+// the new zone isn't traced by the marker thread, so every new Pointer reachable from the roots or the remembered set
+// is traced while the mutator is stopped.
+void ConcurrentMarker::MarkRoots() {
+  ASSERT(paused_);
+  LOG_IF(FATAL, !VisitRoots(this)) << "failed to visit roots.";
+  for (const auto& ptr : heap().remembered_)
+    LOG_IF(FATAL, !ptr->VisitPointers(this)) << "failed to visit remembered pointer: " << (*ptr);
+  for (const auto& slot : heap().remembered_slots_)
+    Visit(slot);
+  ProcessNewPointers();
+}
+
+void ConcurrentMarker::ProcessNewPointers() {
+  while (num_young_scanned_ < young_.size()) {
+    const auto next = young_[num_young_scanned_++];
+    LOG_IF(FATAL, !next->VisitPointers(this)) << "failed to visit: " << (*next);
+  }
+}
+
+auto ConcurrentMarker::ProcessMarkingStack() -> bool {
+  while (!work_.empty()) {
+    // the marker thread leaves the rest of its work for whoever stopped it
+    if (!paused_ && stopping_.load(std::memory_order_relaxed))
+      return true;
+    const auto next = work_.back();
+    work_.pop_back();
+    ASSERT(next && next->GetTag().IsMarked());
+    if (!next->VisitPointers(this))
+      return false;
+  }
+  return true;
+}
+
+// new Pointers are only collected by the next minor collection, so their ephemerons are always traced.
+auto ConcurrentMarker::MarkEphemerons() -> bool {
+  ASSERT(paused_);
+  const auto is_alive = [this](Pointer** ptr) {
+    return !IsOldPointer(*ptr) || (*ptr)->GetTag().IsMarked();
+  };
+  const auto num_young = young_.size();
+  for (auto& ptr : heap().weak_) {
+    if (is_alive(&ptr))
+      LOG_IF(FATAL, !ptr->VisitEphemerons(is_alive, this)) << "failed to visit ephemerons of: " << (*ptr);
+  }
+  return !work_.empty() || young_.size() != num_young;
+}
+
+void ConcurrentMarker::ClearNewMarks() {
+  for (const auto& ptr : young_)
+    ptr->tag().ClearMarkedBit();
+  young_.clear();
+  num_young_scanned_ = 0;
+}
+
+void ConcurrentMarker::Run() {
+  while (true) {
+    LOG_IF(FATAL, !ProcessMarkingStack()) << "failed to process marking stack.";
+    std::vector<PointerList> buffers;
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      if (stopping_)
+        return;
+      if (buffers_.empty()) {
+        idle_.store(true, std::memory_order_release);
+        cond_.wait(lock, [this]() {
+          return !buffers_.empty() || stopping_;
+        });
+        if (stopping_)
+          return;
+        idle_.store(false, std::memory_order_release);
+      }
+      std::swap(buffers, buffers_);
+    }
+    for (const auto& buffer : buffers) {
+      for (const auto& ptr : buffer)
+        Mark(ptr);
+    }
+  }
+}
+
+void ConcurrentMarker::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    stopping_ = true;
+  }
+  cond_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+void ConcurrentMarker::Pause() {
+  ASSERT(!paused_);
+  Stop();
+}
+
+void ConcurrentMarker::Resume() {
+  ASSERT(!paused_ && !thread_.joinable());
+  stopping_ = false;
+  idle_.store(false, std::memory_order_release);
+  thread_ = std::thread(&ConcurrentMarker::Run, this);
+}
+
+void ConcurrentMarker::Log(Pointer* ptr) {
+  ASSERT(ptr && ptr->GetTag().IsOld());
+  buffer_.push_back(ptr);
+  if (buffer_.size() < kSATBBufferSize)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    buffers_.push_back(std::move(buffer_));
+  }
+  buffer_ = PointerList();
+  cond_.notify_one();
+}
+
+void ConcurrentMarker::Start() {
+  DVLOG(1) << "starting concurrent marking....";
+  paused_ = true;
+  MarkRoots();
+  ClearNewMarks();
+  paused_ = false;
+  thread_ = std::thread(&ConcurrentMarker::Run, this);
+}
+
+void ConcurrentMarker::Finish() {
+  Stop();
+  paused_ = true;
+  for (const auto& buffer : buffers_) {
+    for (const auto& ptr : buffer)
+      Mark(ptr);
+  }
+  buffers_.clear();
+  for (const auto& ptr : buffer_)
+    Mark(ptr);
+  buffer_.clear();
+  work_.insert(work_.end(), deferred_.begin(), deferred_.end());
+  deferred_.clear();
+  MarkRoots();
+  do {
+    do {
+      LOG_IF(FATAL, !ProcessMarkingStack()) << "failed to process marking stack.";
+      ProcessNewPointers();
+    } while (!work_.empty());
+  } while (MarkEphemerons());
+  ClearNewMarks();
+  DVLOG(1) << "concurrently marked " << GetNumberOfPointersMarked() << " pointers ("
+           << units::data::byte_t(static_cast<double>(GetNumberOfBytesMarked())) << ").";
+}
+}  // namespace gel
@@ -1,16 +1,135 @@
 #ifndef GEL_MARKER_H
 #define GEL_MARKER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "gel/common.h"
+#include "gel/flags.h"
 #include "gel/pointer.h"
 
 namespace gel {
-class Marker : public PointerVisitor {
+class Heap;
+class Marker : public PointerPointerVisitor {
   DEFINE_NON_COPYABLE_TYPE(Marker);
 
+ private:
+  Heap& heap_;
+  std::vector<Pointer*> work_{};
+  uword num_marked_ = 0;
+  uword bytes_marked_ = 0;
+
+  inline auto heap() const -> Heap& {
+    return heap_;
+  }
+
+ protected:
+  auto IsHeapPointer(Pointer* ptr) const -> bool;
+  auto ProcessMarkingStack() -> bool;
+  // marks the values of the ephemerons w/ a marked key, returns false once no new Pointers were marked.
+  auto MarkEphemerons() -> bool;
+
  public:
-  Marker() = default;
+  explicit Marker(Heap& heap) :
+    PointerPointerVisitor(),
+    heap_(heap) {}
   ~Marker() override = default;
+
+  auto GetNumberOfPointersMarked() const -> uword {
+    return num_marked_;
+  }
+
+  auto GetNumberOfBytesMarked() const -> uword {
+    return bytes_marked_;
+  }
+
+  auto Visit(Pointer** ptr) -> bool override;
+  // marks every Pointer reachable from the roots, in both the new & old zones.
+  void MarkAll();
+  // clears the marked bit of every Pointer left in the new zone.
+  void ClearMarks();
+};
+
+DECLARE_uword(concurrent_mark_threshold);
+
+static inline auto GetConcurrentMarkThreshold() -> uword {
+  return FLAGS_concurrent_mark_threshold;
+}
+
+// marks the old zone on a background thread while the mutator keeps running (snapshot-at-the-beginning). the mutator
+// logs every old Pointer it overwrites (see PreWriteBarrier) & old Pointers allocated while marking start out marked.
+// the new zone is only traced during the initial mark & the remark pauses, the marker thread only follows old Pointers.
+class ConcurrentMarker : public PointerPointerVisitor {
+  DEFINE_NON_COPYABLE_TYPE(ConcurrentMarker);
+
+ public:
+  static constexpr const uword kSATBBufferSize = 1024;
+
+ private:
+  Heap& heap_;
+  std::thread thread_{};
+  std::mutex lock_{};
+  std::condition_variable cond_{};
+  std::vector<PointerList> buffers_{};  // full SATB buffers handed over by the mutator
+  std::atomic<bool> stopping_{false};  // also read by the marker thread between Pointers, see Pause
+  std::atomic<bool> idle_{false};
+  PointerList buffer_{};    // the SATB buffer being filled by the mutator
+  PointerList work_{};      // gray old Pointers
+  PointerList deferred_{};  // gray old Pointers w/ off-heap pointers, see Object::HasOffHeapPointers
+  PointerList young_{};     // new Pointers marked during a pause, their marks are cleared before the mutator resumes
+  uword num_young_scanned_ = 0;
+  bool paused_ = true;
+  uword num_marked_ = 0;
+  uword bytes_marked_ = 0;
+
+  inline auto heap() const -> Heap& {
+    return heap_;
+  }
+
+  auto IsOldPointer(Pointer* ptr) const -> bool;
+  auto IsNewPointer(Pointer* ptr) const -> bool;
+  void Mark(Pointer* ptr);
+  void MarkRoots();
+  void ProcessNewPointers();
+  auto ProcessMarkingStack() -> bool;
+  auto MarkEphemerons() -> bool;
+  void ClearNewMarks();
+  void Run();
+  void Stop();
+
+ public:
+  explicit ConcurrentMarker(Heap& heap) :
+    PointerPointerVisitor(),
+    heap_(heap) {}
+  ~ConcurrentMarker() override;
+
+  auto GetNumberOfPointersMarked() const -> uword {
+    return num_marked_;
+  }
+
+  auto GetNumberOfBytesMarked() const -> uword {
+    return bytes_marked_;
+  }
+
+  // true once the marker thread ran out of work, the mutator should remark at its next safepoint.
+  auto IsIdle() const -> bool {
+    return idle_.load(std::memory_order_acquire);
+  }
+
+  auto Visit(Pointer** ptr) -> bool override;
+  // logs an overwritten old Pointer, called by the mutator thread.
+  void Log(Pointer* ptr);
+  // the initial mark pause, marks through the roots & the new zone then starts the marker thread.
+  void Start();
+  // the remark pause, stops the marker thread & marks whatever was logged or is reachable from the roots since.
+  void Finish();
+  // stops the marker thread w/o finishing the cycle, the scavenger rewrites the slots of old Pointers it would read.
+  void Pause();
+  // restarts the marker thread w/ the work that was left when it was paused.
+  void Resume();
 };
 }  // namespace gel
 
@@ -49,7 +49,16 @@ class MemoryRegion : public Region {
   ~MemoryRegion() override = default;
 
   virtual void FreeRegion();
-  virtual void Protect(const ProtectionMode mode);
+  virtual void Protect(const uword offset, const uword size, const ProtectionMode mode);
+  // hands the pages backing [offset, offset + size) back to the OS w/o unmapping them, their contents are undefined
+  // afterwards (zero on linux, possibly stale on osx where the OS reclaims them lazily).
+  virtual void Release(const uword offset, const uword size);
+  // hints the OS to back this region w/ transparent huge pages (where supported).
+  virtual void AdviseHugePages();
+
+  inline void Protect(const ProtectionMode mode) {
+    return Protect(0, GetSize(), mode);
+  }
 
   friend auto operator<<(std::ostream& stream, const MemoryRegion& rhs) -> std::ostream& {
     stream << "MemoryRegion(";
@@ -58,6 +67,9 @@ class MemoryRegion : public Region {
     stream << ")";
     return stream;
   }
+
+ public:
+  static auto GetPageSize() -> uword;
 };
 }  // namespace gel
 
@@ -0,0 +1,122 @@
+#include "gel/memory_region.h"
+#ifdef OS_IS_LINUX
+
+#include <glog/logging.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <units.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "gel/common.h"
+
+namespace gel {
+using namespace units::data;
+
+static constexpr const uword kHugePageSize = 2 * 1024 * 1024;
+
+static inline auto IsMapFailed(const void* ptr) -> bool {
+  return ptr == MAP_FAILED;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+}
+
+static inline auto GetError() -> std::string {
+  return strerror(errno);
+}
+
+static inline void Unmap(const uword start, const uword size) {
+  if (size == 0)
+    return;
+  const auto error = munmap((void*)start, size);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  LOG_IF(FATAL, error != 0) << "failed to munmap " << byte_t(static_cast<double>(size)) << ": " << GetError();
+}
+
+// reserves `size` bytes of address space w/o committing any memory, regions large enough to hold a huge page are aligned
+// to the huge page size so they can be backed by transparent huge pages.
+static inline auto Reserve(const uword requested) -> uword {
+  const auto size = RoundUp(requested, MemoryRegion::GetPageSize());
+  const auto alignment = size >= kHugePageSize ? kHugePageSize : MemoryRegion::GetPageSize();
+  const auto reserved_size = size + alignment;
+  const auto ptr = mmap(nullptr, reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  LOG_IF(FATAL, IsMapFailed(ptr)) << "failed to mmap MemoryRegion of " << byte_t(static_cast<double>(reserved_size))
+                                  << ": " << GetError();
+  const auto start = (uword)ptr;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  const auto aligned = RoundUp(start, alignment);
+  Unmap(start, aligned - start);
+  Unmap(aligned + size, (start + reserved_size) - (aligned + size));
+  return aligned;
+}
+
+MemoryRegion::MemoryRegion(const uword size, const ProtectionMode mode) :
+  MemoryRegion() {
+  // records exactly what was reserved, so FreeRegion unmaps all of it
+  const auto total_size = RoundUp(size, GetPageSize());
+  SetStartingAddress(Reserve(total_size));
+  SetSize(total_size);
+  VLOG(1000) << "created " << (*this);
+  Protect(mode);
+}
+
+void MemoryRegion::FreeRegion() {
+  if (!IsAllocated())
+    return;
+  int error = munmap(GetStartingAddressPointer(), GetSize());
+  LOG_IF(FATAL, error != 0) << "failed to munmap " << (*this) << ": " << GetError();
+  VLOG(1000) << "freed " << (*this);
+  SetSize(0);
+  SetStartingAddress(0);
+}
+
+void MemoryRegion::Protect(const uword offset, const uword size, const ProtectionMode mode) {
+  ASSERT((offset + size) <= GetSize());
+  int protection = PROT_NONE;
+  switch (mode) {
+    case kReadOnly:
+      protection = PROT_READ;
+      break;
+    case kReadWrite:
+      protection = PROT_READ | PROT_WRITE;
+      break;
+    case kReadExecute:
+      protection = PROT_READ | PROT_EXEC;
+      break;
+    case kReadWriteExecute:
+      protection = PROT_READ | PROT_WRITE | PROT_EXEC;
+      break;
+    case kNoAccess:
+    default:
+      break;
+  }
+
+  const auto start = (void*)(GetStartingAddress() + offset);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  int error = mprotect(start, size, protection);
+  LOG_IF(FATAL, error != 0) << "failed to protect " << (*this) << " w/ " << mode << ": " << GetError();
+  DVLOG(1000) << "changed " << (*this) << " protection to: " << mode;
+}
+
+void MemoryRegion::Release(const uword offset, const uword size) {
+  ASSERT((offset + size) <= GetSize());
+  const auto start = RoundUp(GetStartingAddress() + offset, GetPageSize());
+  const auto end = RoundDown(GetStartingAddress() + offset + size, GetPageSize());
+  if (end <= start)
+    return;
+  int error = madvise((void*)start, end - start, MADV_DONTNEED);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  LOG_IF(ERROR, error != 0) << "failed to release " << byte_t(static_cast<double>(end - start)) << " of " << (*this)
+                            << ": " << GetError();
+}
+
+void MemoryRegion::AdviseHugePages() {
+#ifdef MADV_HUGEPAGE
+  int error = madvise(GetStartingAddressPointer(), GetSize(), MADV_HUGEPAGE);
+  LOG_IF(WARNING, error != 0) << "failed to advise huge pages for " << (*this) << ": " << GetError();
+#endif  // MADV_HUGEPAGE
+}
+
+auto MemoryRegion::GetPageSize() -> uword {
+  static const auto kPageSize = static_cast<uword>(sysconf(_SC_PAGESIZE));
+  return kPageSize;
+}
+}  // namespace gel
+
+#endif  // OS_IS_LINUX
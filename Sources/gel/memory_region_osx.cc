@@ -3,6 +3,7 @@
 
 #include <glog/logging.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #include <units.h>
 
 #include "gel/common.h"
@@ -43,7 +44,8 @@ void MemoryRegion::FreeRegion() {
   SetStartingAddress(0);
 }
 
-void MemoryRegion::Protect(const ProtectionMode mode) {
+void MemoryRegion::Protect(const uword offset, const uword size, const ProtectionMode mode) {
+  ASSERT((offset + size) <= GetSize());
   int protection = PROT_NONE;
   switch (mode) {
     case kReadOnly:
@@ -63,10 +65,31 @@ void MemoryRegion::Protect(const ProtectionMode mode) {
       break;
   }
 
-  int error = mprotect(GetStartingAddressPointer(), GetSize(), protection);
+  const auto start = (void*)(GetStartingAddress() + offset);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  int error = mprotect(start, size, protection);
   LOG_IF(FATAL, error != 0) << "failed to protect " << (*this) << " w/ " << mode;
   DVLOG(1000) << "changed " << (*this) << " protection to: " << mode;
 }
+
+void MemoryRegion::Release(const uword offset, const uword size) {
+  ASSERT((offset + size) <= GetSize());
+  const auto start = RoundUp(GetStartingAddress() + offset, GetPageSize());
+  const auto end = RoundDown(GetStartingAddress() + offset + size, GetPageSize());
+  if (end <= start)
+    return;
+  int error = madvise((void*)start, end - start, MADV_FREE);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  LOG_IF(ERROR, error != 0) << "failed to release " << byte_t(static_cast<double>(end - start)) << " of " << (*this)
+                            << ": " << GetError();
+}
+
+void MemoryRegion::AdviseHugePages() {
+  // superpages are only available via mach_vm_allocate on OSX.
+}
+
+auto MemoryRegion::GetPageSize() -> uword {
+  static const auto kPageSize = static_cast<uword>(getpagesize());
+  return kPageSize;
+}
 }  // namespace gel
 
 #endif  // OS_IS_OSX
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "gel/module.h"
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/macro.h"
 #include "gel/parser.h"
@@ -138,10 +139,13 @@ auto Module::VisitPointers(PointerPointerVisitor* vis) -> bool {
       return false;
     name_ = name_ptr->As<String>();
   }
-  DLOG(INFO) << "visiting: " << scope_->ToString();
-  LOG_IF(FATAL, !scope_->VisitLocalPointers([vis](Pointer** ptr) {
-    return vis->Visit(ptr);
-  })) << "failed to visit pointers in scope.";
+  DVLOG(1000) << "visiting: " << scope_->ToString();
+  LOG_IF(FATAL, !scope_->VisitLocalPointers(
+                    [vis](Pointer** ptr) {
+                      return vis->Visit(ptr);
+                    },
+                    false))
+      << "failed to visit pointers in scope.";
   for (auto& ns : namespaces_) {
     auto ns_ptr = ns->raw_ptr();
     if (!vis->Visit(&ns_ptr))
@@ -158,6 +162,7 @@ auto Module::CreateClass() -> Class* {
   ASSERT(cls);
   kFieldInitialized = cls->AddField("initialized");
   ASSERT(kFieldInitialized);
+  AddRoot(&kFieldInitialized);
   return cls;
 }
 
@@ -59,6 +59,10 @@ class Module : public Object {
  public:
   ~Module() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto IsInitialized() const -> bool {
     ASSERT(kFieldInitialized);
     return GetField(kFieldInitialized)->AsBool()->Get();
@@ -0,0 +1,138 @@
+#ifndef GEL_NAN_BOX_H
+#define GEL_NAN_BOX_H
+
+#include <bit>
+#include <cmath>
+
+#include "gel/common.h"
+#include "gel/object.h"
+#include "gel/platform.h"
+
+namespace gel {
+// a 64-bit word holding an unboxed double, an unboxed 48-bit integer or an Object*. doubles are stored as is & every NaN
+// is canonicalized, which leaves the negative quiet NaNs free to tag the other two:
+//   [1111 1111 1111 1001][48-bit Object*]
+//   [1111 1111 1111 1010][48-bit two's complement integer]
+// the interpreter keeps its operands NaN-boxed when compiled w/ GEL_ENABLE_NAN_BOXING, see OperationStack.
+class NanBox {
+  DEFINE_DEFAULT_COPYABLE_TYPE(NanBox);
+
+ private:
+  static constexpr const uint64_t kTagMask = 0xFFFF000000000000;
+  static constexpr const uint64_t kPayloadMask = ~kTagMask;
+  static constexpr const uint64_t kObjectTag = 0xFFF9000000000000;
+  static constexpr const uint64_t kLongTag = 0xFFFA000000000000;
+  static constexpr const uint64_t kCanonicalNaN = 0x7FF8000000000000;
+  static constexpr const int kPayloadBits = 48;
+  static constexpr const int64_t kMinLongValue = -(static_cast<int64_t>(1) << (kPayloadBits - 1));
+  static constexpr const int64_t kMaxLongValue = (static_cast<int64_t>(1) << (kPayloadBits - 1)) - 1;
+
+  uint64_t raw_;
+
+  constexpr explicit NanBox(const uint64_t raw) :
+    raw_(raw) {}
+
+ public:
+  constexpr NanBox() :
+    raw_(kObjectTag) {}
+  ~NanBox() = default;
+
+  constexpr auto raw() const -> uint64_t {
+    return raw_;
+  }
+
+  constexpr auto IsObject() const -> bool {
+    return (raw() & kTagMask) == kObjectTag;
+  }
+
+  constexpr auto IsLong() const -> bool {
+    return (raw() & kTagMask) == kLongTag;
+  }
+
+  constexpr auto IsDouble() const -> bool {
+    return !IsObject() && !IsLong();
+  }
+
+  constexpr auto IsNumber() const -> bool {
+    return !IsObject();
+  }
+
+  inline auto GetObject() const -> Object* {
+    ASSERT(IsObject());
+    return (Object*)(raw() & kPayloadMask);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  }
+
+  inline auto GetLong() const -> uint64_t {
+    ASSERT(IsLong());
+    // sign extends the payload
+    return static_cast<uint64_t>(static_cast<int64_t>(raw() << (64 - kPayloadBits)) >> (64 - kPayloadBits));
+  }
+
+  inline auto GetDouble() const -> double {
+    ASSERT(IsDouble());
+    return std::bit_cast<double>(raw());
+  }
+
+  // the value of a number as a double, integers convert like they do in Double's arithmetic.
+  inline auto AsDouble() const -> double {
+    ASSERT(IsNumber());
+    return IsLong() ? static_cast<double>(GetLong()) : GetDouble();
+  }
+
+  // the value of a number as an integer, doubles truncate like they do in Long's arithmetic.
+  inline auto AsLong() const -> uint64_t {
+    ASSERT(IsNumber());
+    return IsLong() ? GetLong() : static_cast<uint64_t>(GetDouble());
+  }
+
+  // allocates a Long or Double for an unboxed number.
+  inline auto Box() const -> Object* {
+    if (IsObject())
+      return GetObject();
+    else if (IsLong())
+      return Long::New(GetLong());
+    return Double::New(GetDouble());
+  }
+
+  constexpr auto operator==(const NanBox& rhs) const -> bool {
+    return raw() == rhs.raw();
+  }
+
+ public:
+  static inline auto Of(Object* rhs) -> NanBox {
+    const auto address = (uword)rhs;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    ASSERT((address & kTagMask) == 0);
+    return NanBox(kObjectTag | address);
+  }
+
+  static constexpr auto FitsLong(const uint64_t rhs) -> bool {
+    const auto value = static_cast<int64_t>(rhs);
+    return value >= kMinLongValue && value <= kMaxLongValue;
+  }
+
+  // integers that don't fit into the payload stay boxed.
+  static inline auto OfLong(const uint64_t rhs) -> NanBox {
+    if (!FitsLong(rhs))
+      return Of(Long::New(rhs));
+    return NanBox(kLongTag | (rhs & kPayloadMask));
+  }
+
+  static inline auto OfDouble(const double rhs) -> NanBox {
+    return NanBox(std::isnan(rhs) ? kCanonicalNaN : std::bit_cast<uint64_t>(rhs));
+  }
+
+  // unboxes Longs & Doubles, anything else is kept as an Object*. never allocates, a Long that doesn't fit into the
+  // payload is kept as is.
+  static inline auto Unbox(Object* rhs) -> NanBox {
+    if (IsSmi(rhs))
+      return OfLong(SmiValue(rhs));
+    else if (rhs && rhs->IsLong() && FitsLong(rhs->AsLong()->Get()))
+      return OfLong(rhs->AsLong()->Get());
+    else if (rhs && rhs->IsDouble())
+      return OfDouble(rhs->AsDouble()->Get());
+    return Of(rhs);
+  }
+};
+}  // namespace gel
+
+#endif  // GEL_NAN_BOX_H
@@ -65,6 +65,20 @@ auto NativeProcedure::Find(Symbol* symbol) -> NativeProcedure* {
   return nullptr;
 }
 
+auto NativeProcedure::VisitNativeProcedurePointers(const std::function<bool(Pointer**)>& vis) -> bool {
+  for (auto& native : all_) {
+    ASSERT(native);
+    if (!VisitPointer(vis, &native))
+      return false;
+  }
+  return true;
+}
+
+auto NativeProcedure::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return Procedure::VisitPointers(vis) && VisitPointer(vis, &docs_);
+}
+
 auto NativeProcedure::FindOrCreate(Symbol* symbol) -> NativeProcedure* {
   ASSERT(symbol);
   for (const auto& native : all_) {
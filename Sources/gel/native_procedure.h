@@ -5,6 +5,7 @@
 #include <variant>
 
 #include "gel/argument.h"
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/error.h"
 #include "gel/procedure.h"
@@ -222,6 +223,8 @@ class NativeProcedure : public Procedure {
     docs_ = rhs;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~NativeProcedure() override = default;
 
@@ -266,6 +269,7 @@ class NativeProcedure : public Procedure {
   static void Init();
   static auto Find(const std::string& name) -> NativeProcedure*;
   static auto Find(Symbol* symbol) -> NativeProcedure*;
+  static auto VisitNativeProcedurePointers(const std::function<bool(Pointer**)>& vis) -> bool;
 
   static inline auto GetAll() -> const NativeProcedureList& {
     return all_;
@@ -333,6 +337,7 @@ static inline auto InitNative() -> Native* {
     ASSERT(kInstance);                                  \
     kSymbol = Symbol::New(kSymbolString);               \
     ASSERT(kSymbol);                                    \
+    AddRoot(&kSymbol);                                  \
     NativeProcedure::Link(kSymbol, kInstance);          \
   }                                                     \
   auto Name::Apply(const ObjectList& args) const -> bool
@@ -24,6 +24,7 @@
 #include "gel/event_loop.h"
 #include "gel/gel.h"
 #include "gel/heap.h"
+#include "gel/heap_snapshot.h"
 #include "gel/local.h"
 #include "gel/local_scope.h"
 #include "gel/module_loader.h"
@@ -57,7 +58,11 @@ void NativeProcedure::InitNatives() {
   InitNative<rand_range>();
   InitNative<gel_docs>();
   InitNative<gel_load_bindings>();
+  InitNative<gel_gc_stats>();
+  InitNative<gel_heap_snapshot>();
   InitNative<get_event_loop>();
+  InitNative<gel_yield>();
+  InitNative<gel_register_finalizer>();
 
   InitNative<get_namespace>();
   InitNative<ns_get>();
@@ -67,6 +72,7 @@ void NativeProcedure::InitNatives() {
   InitTimerNative(start);
   InitTimerNative(stop);
   InitTimerNative(again);
+  InitTimerNative(close);
   InitTimerNative(get_due_in);
   InitTimerNative(get_repeat);
   InitTimerNative(set_repeat);
@@ -85,6 +91,16 @@ void NativeProcedure::InitNatives() {
   InitMapNative(get);
 #undef InitMapNative
 
+  InitNative<weak_ref_get>();
+#define InitWeakMapNative(Name) InitNative<weak_map_##Name>()
+  InitWeakMapNative(contains);
+  InitWeakMapNative(empty);
+  InitWeakMapNative(size);
+  InitWeakMapNative(get);
+  InitWeakMapNative(put);
+  InitWeakMapNative(remove);
+#undef InitWeakMapNative
+
 // TODO: add sandbox switch
 #define InitFsNative(Name) InitNative<fs_##Name>();
   InitFsNative(get_cwd);
@@ -171,6 +187,59 @@ NATIVE_PROCEDURE_F(gel_sizeof) {
   return ReturnLong(value->GetType()->GetAllocationSize());
 }
 
+NATIVE_PROCEDURE_F(gel_gc_stats) {
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  const auto& stats = heap->GetStats();
+  static const auto kToMicroseconds = [](const Clock::duration& duration) {
+    return static_cast<uword>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  };
+  // snapshot the stats first, building the result allocates & might collect
+  std::vector<std::pair<std::string, uword>> values = {
+      {"bytes-allocated", stats.GetNumberOfBytesAllocated()},
+      {"bytes-copied", stats.GetNumberOfBytesCopied()},
+      {"bytes-promoted", stats.GetNumberOfBytesPromoted()},
+      {"bytes-freed", stats.GetNumberOfBytesFreed()},
+      {"survival-rate", stats.GetSurvivalRate()},
+      {"allocation-rate", stats.GetAllocationRate()},
+      {"heap-used", heap->GetNumberOfBytesAllocated()},
+      {"heap-size", heap->GetTotalSize()},
+      {"pause-total-us", kToMicroseconds(stats.GetTotalPause())},
+  };
+  for (auto kind = 0; kind < GCEvent::kNumberOfKinds; kind++) {
+    const auto& pauses = stats.GetPauses(static_cast<GCEvent::Kind>(kind));
+    std::stringstream ss;
+    ss << static_cast<GCEvent::Kind>(kind);
+    const auto name = ss.str();
+    values.emplace_back(name + "-count", pauses.GetNumberOfPauses());
+    values.emplace_back(name + "-pause-mean-us", kToMicroseconds(pauses.GetMeanPause()));
+    values.emplace_back(name + "-pause-p99-us", kToMicroseconds(pauses.GetPercentile(99)));
+    values.emplace_back(name + "-pause-max-us", kToMicroseconds(pauses.GetMaxPause()));
+  }
+  Object* result = Null();
+  ScopedRoot<Object> root(&result);
+  for (const auto& [name, value] : std::ranges::reverse_view(values))
+    result = Cons(Cons(Symbol::New(name), Long::New(value)), result);
+  return Return(result);
+}
+
+NATIVE_PROCEDURE_F(gel_heap_snapshot) {
+  auto filename = GetReportFilename("heap.snapshot");
+  if (!args.empty()) {
+    NativeArgument<0, String> value(args);
+    if (!value)
+      return Throw(value.GetError());
+    filename = value->Get();
+  }
+  const auto heap = Heap::GetHeap();
+  ASSERT(heap);
+  HeapSnapshot snapshot;
+  snapshot.Take(*heap);
+  if (!snapshot.WriteTo(filename))
+    return ThrowError(fmt::format("failed to write heap snapshot to: {}", filename));
+  return ReturnNew<String>(filename);
+}
+
 NATIVE_PROCEDURE_F(gel_docs) {
   if (args.empty())
     return DoNothing();
@@ -320,6 +389,8 @@ NATIVE_PROCEDURE_F(set_car) {
   NativeArgument<1> value(args);
   if (!value)
     return Throw(value.GetError());
+  if (IsImmortal(seq))
+    return ThrowError(fmt::format("cannot modify immutable `{}`", seq->ToString()));
   SetCar(seq, value);
   return DoNothing();
 }
@@ -331,6 +402,8 @@ NATIVE_PROCEDURE_F(set_cdr) {
   NativeArgument<1> value(args);
   if (!value)
     return Throw(value.GetError());
+  if (IsImmortal(seq))
+    return ThrowError(fmt::format("cannot modify immutable `{}`", seq->ToString()));
   SetCdr(seq, value);
   return DoNothing();
 }
@@ -358,6 +431,26 @@ NATIVE_PROCEDURE_F(get_event_loop) {
   return Return(GetThreadEventLoop());
 }
 
+NATIVE_PROCEDURE_F(gel_yield) {
+  const auto runtime = GetRuntime();
+  ASSERT(runtime);
+  runtime->GetScheduler()->Yield();
+  return Return();
+}
+
+NATIVE_PROCEDURE_F(gel_register_finalizer) {
+  NativeArgument<0> target(args);
+  if (!target)
+    return Throw(target.GetError());
+  NativeArgument<1, Procedure> on_finalize(args);
+  if (!on_finalize)
+    return Throw(on_finalize.GetError());
+  const auto loop = GetThreadEventLoop();
+  ASSERT(loop);
+  loop->AddFinalizer(target, on_finalize);
+  return Return();
+}
+
 #define TIMER_PROCEDURE_F(Name) NATIVE_PROCEDURE_F(timer_##Name)
 
 TIMER_PROCEDURE_F(start) {
@@ -445,6 +538,17 @@ TIMER_PROCEDURE_F(get_due_in) {
   return ReturnNew<Long>(timer->GetDueIn());
 }
 
+TIMER_PROCEDURE_F(close) {
+  NativeArgument<0, Long> id(args);
+  if (!id)
+    return Throw(id.GetError());
+  const auto loop = GetThreadEventLoop();
+  ASSERT(loop);
+  if (!loop->CloseTimer(id->Get()))
+    return ThrowError(fmt::format("failed to find Timer w/ id {}", id->Get()));
+  return Return();
+}
+
 #undef TIMER_PROCEDURE_F
 
 NATIVE_PROCEDURE_F(create_timer) {
@@ -19,7 +19,11 @@ _DECLARE_NATIVE_PROCEDURE(set_cdr, "set-cdr!");
 DECLARE_NATIVE_PROCEDURE(hashcode);
 _DECLARE_NATIVE_PROCEDURE(gel_sizeof, "sizeof");
 _DECLARE_NATIVE_PROCEDURE(gel_load_bindings, "gel/load-bindings");
+_DECLARE_NATIVE_PROCEDURE(gel_gc_stats, "gel/gc-stats");
+_DECLARE_NATIVE_PROCEDURE(gel_heap_snapshot, "gel/heap-snapshot");
 _DECLARE_NATIVE_PROCEDURE(get_event_loop, "get-event-loop");
+_DECLARE_NATIVE_PROCEDURE(gel_yield, "gel/yield!");
+_DECLARE_NATIVE_PROCEDURE(gel_register_finalizer, "gel/register-finalizer!");
 
 // ----------------------------------------------------------------------------------------------------
 // Class
@@ -46,6 +50,7 @@ _DECLARE_NATIVE_PROCEDURE(ns_get, "ns:get");
 DECLARE_TIMER_PROCEDURE(start);
 DECLARE_TIMER_PROCEDURE(stop);
 DECLARE_TIMER_PROCEDURE(again);
+DECLARE_TIMER_PROCEDURE(close);
 _DECLARE_TIMER_PROCEDURE(get_due_in, "get-due-in");
 _DECLARE_TIMER_PROCEDURE(get_repeat, "get-repeat");
 _DECLARE_TIMER_PROCEDURE(set_repeat, "set-repeat!");
@@ -84,6 +89,25 @@ _DECLARE_MAP_PROCEDURE(empty, "empty?");
 #undef DECLARE_SET_PROCEDURE
 // ----------------------------------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------------------------------
+// WeakRef & WeakMap
+// ----------------------------------------------------------------------------------------------------
+_DECLARE_NATIVE_PROCEDURE(weak_ref_get, "WeakRef/get");
+
+#define _DECLARE_WEAK_MAP_PROCEDURE(Name, Sym) _DECLARE_NATIVE_PROCEDURE(weak_map_##Name, "WeakMap/" Sym)
+#define DECLARE_WEAK_MAP_PROCEDURE(Name)       _DECLARE_WEAK_MAP_PROCEDURE(Name, #Name);
+
+DECLARE_WEAK_MAP_PROCEDURE(contains);
+DECLARE_WEAK_MAP_PROCEDURE(size);
+DECLARE_WEAK_MAP_PROCEDURE(get);
+_DECLARE_WEAK_MAP_PROCEDURE(put, "put!");
+_DECLARE_WEAK_MAP_PROCEDURE(remove, "remove!");
+_DECLARE_WEAK_MAP_PROCEDURE(empty, "empty?");
+
+#undef _DECLARE_WEAK_MAP_PROCEDURE
+#undef DECLARE_WEAK_MAP_PROCEDURE
+// ----------------------------------------------------------------------------------------------------
+
 #ifdef GEL_ENABLE_RX
 #define _DECLARE_NATIVE_RX_PROCEDURE(Name, Sym) _DECLARE_NATIVE_PROCEDURE(rx_##Name, "rx/" Sym)
 #define DECLARE_NATIVE_RX_PROCEDURE(Name)       _DECLARE_NATIVE_RX_PROCEDURE(Name, #Name)
@@ -100,7 +100,7 @@ NATIVE_PROCEDURE_F(gel_get_frame) {
   const auto runtime = GetRuntime();
   ASSERT(runtime);
   DLOG(INFO) << "stack frames:";
-  StackFrameIterator iter(runtime->stack_);
+  StackFrameIterator iter(runtime->frames_);
   while (iter.HasNext()) {
     DLOG(INFO) << "- " << iter.Next();
   }
@@ -111,7 +111,7 @@ NATIVE_PROCEDURE_F(gel_print_st) {
   const auto runtime = GetRuntime();
   ASSERT(runtime);
   LOG(INFO) << "Stack Trace:";
-  StackFrameIterator iter(runtime->stack_);
+  StackFrameIterator iter(runtime->frames_);
   while (iter.HasNext()) {
     const auto& next = iter.Next();
     LOG(INFO) << "  " << next.GetId() << ": " << next.GetTargetName();
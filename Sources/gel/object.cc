@@ -2,6 +2,7 @@
 
 #include <glog/logging.h>
 
+#include <array>
 #include <exception>
 #include <iterator>
 #include <rpp/observers/fwd.hpp>
@@ -13,10 +14,12 @@
 
 #include "gel/array.h"
 #include "gel/buffer.h"
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/event_loop.h"
 #include "gel/expression.h"
 #include "gel/heap.h"
+#include "gel/immortal_space.h"
 #include "gel/macro.h"
 #include "gel/module.h"
 #include "gel/namespace.h"
@@ -30,6 +33,7 @@
 #include "gel/symbol.h"
 #include "gel/to_string_helper.h"
 #include "gel/type.h"
+#include "gel/weak_ref.h"
 namespace gel {
 #ifdef GEL_DISABLE_HEAP
 
@@ -40,14 +44,11 @@ namespace gel {
 
 #else
 
-#define DEFINE_NEW_OPERATOR(Name)                                             \
-  auto Name::operator new(const size_t sz) -> void* {                         \
-    const auto alloc_size = Name::kClass ? kClass->GetAllocationSize() : sz;  \
-    const auto heap = Heap::GetHeap();                                        \
-    ASSERT(heap);                                                             \
-    const auto address = heap->TryAllocate(alloc_size > 0 ? alloc_size : sz); \
-    ASSERT(address != UNALLOCATED);                                           \
-    return reinterpret_cast<void*>(address);                                  \
+#define DEFINE_NEW_OPERATOR(Name)                                                               \
+  auto Name::operator new(const size_t sz) -> void* {                                           \
+    const auto address = Heap::Allocate(kClass ? kClass->GetAllocationSize() : sz, kClassName); \
+    ASSERT(address != UNALLOCATED);                                                             \
+    return reinterpret_cast<void*>(address);                                                    \
   }
 
 #endif  // GEL_DISABLE_HEAP
@@ -55,12 +56,14 @@ namespace gel {
 FOR_EACH_TYPE(DEFINE_NEW_OPERATOR)  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
 #undef DEFINE_NEW_OPERATOR
 
-#define DEFINE_INIT_CLASS(Name)  \
-  Class* Name::kClass = nullptr; \
-  void Name::InitClass() {       \
-    ASSERT(kClass == nullptr);   \
-    kClass = CreateClass();      \
-    ASSERT(kClass);              \
+#define DEFINE_INIT_CLASS(Name)     \
+  Class* Name::kClass = nullptr;    \
+  void Name::InitClass() {          \
+    ASSERT(kClass == nullptr);      \
+    kClass = CreateClass();         \
+    ASSERT(kClass);                 \
+    kClass->Finalize(sizeof(Name)); \
+    AddRoot(&kClass);               \
   }
 DEFINE_INIT_CLASS(Object);
 FOR_EACH_TYPE(DEFINE_INIT_CLASS)
@@ -117,22 +120,25 @@ auto Object::Compare(Object* rhs) const -> int {
 }
 
 void Object::Init() {
+  ImmortalSpace::Init();
   InitClass();
   Class::Init();
   Field::InitClass();
-  String::InitClass();
+  String::Init();
   Symbol::Init();
   Namespace::InitClass();
   Module::InitClass();
   Seq::InitClass();
   Map::InitClass();
+  WeakRef::InitClass();
+  WeakMap::InitClass();
   Procedure::InitClass();
   Lambda::InitClass();
   NativeProcedure::Init();
   Buffer::Init();
   Script::InitClass();
   Number::InitClass();
-  Long::InitClass();
+  Long::Init();
   Double::InitClass();
   Pair::InitClass();
   Bool::Init();
@@ -149,12 +155,37 @@ void Object::Init() {
   ReplaySubject::InitClass();
   PublishSubject::InitClass();
 #endif  // GEL_ENABLE_RX
+  // every canonical Object has to exist before the ImmortalSpace is write protected
+  Pair::Empty();
+  Set::Empty();
+  Map::Empty();
+  ImmortalSpace::Protect();
 }
 
 auto Long::CreateClass() -> Class* {
   return Class::New(Class::kLongClassId, Number::GetClass(), kClassName);
 }
 
+static_assert(sizeof(Long) == sizeof(Number));
+uword Long::kSmiTable = UNALLOCATED;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void Long::Init() {
+  InitClass();
+  InitSmis();
+}
+
+void Long::InitSmis() {
+  ASSERT(kSmiTable == UNALLOCATED);
+  for (uword idx = 0; idx < kNumberOfSmis; idx++) {
+    const auto address = ImmortalSpace::Allocate(sizeof(Long));
+    // the Smis are looked up by their index, so the table must be contiguous
+    ASSERT(idx == 0 || (address - sizeof(Pointer)) == (kSmiTable + (idx * kSmiSize)));
+    ::new ((void*)address) Long(static_cast<uint64_t>(kMinSmiValue) + idx);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    if (idx == 0)
+      kSmiTable = address - sizeof(Pointer);
+  }
+}
+
 auto Long::New(const ObjectList& args) -> Long* {
   NOT_IMPLEMENTED(FATAL);  // TODO: implement
 }
@@ -220,12 +251,12 @@ auto Bool::CreateClass() -> Class* {
 
 void Bool::Init() {
   InitClass();
-  kTrue = NewTrue();
-  kFalse = NewFalse();
+  kTrue = ::new ((void*)ImmortalSpace::Allocate(sizeof(Bool))) Bool(true);    // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  kFalse = ::new ((void*)ImmortalSpace::Allocate(sizeof(Bool))) Bool(false);  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
 }
 
 auto Bool::New(const bool value) -> Bool* {
-  return new Bool(value);
+  return Box(value);
 }
 
 auto Bool::True() -> Bool* {
@@ -243,6 +274,18 @@ auto Object::FieldAddr(Field* field) const -> Object** {
   return FieldAddrAtOffset(field->GetOffset());
 }
 
+auto Object::VisitFieldPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  const auto cls = GetType();
+  if (!cls || !cls->HasFieldOffsets())
+    return true;
+  for (const auto& offset : cls->GetFieldOffsets()) {
+    if (!VisitPointer(vis, FieldAddrAtOffset(offset)))
+      return false;
+  }
+  return true;
+}
+
 auto Bool::HashCode() const -> uword {
   uword hash = 0;
   CombineHash(hash, Get());
@@ -303,7 +346,7 @@ DEFINE_BINARY_OP(Mod, %);
 #undef DEFINE_BINARY_OP
 
 auto Long::Compare(Object* rhs) const -> int {
-  ASSERT(rhs && rhs->IsLong());
+  ASSERT(rhs && (gel::IsSmi(rhs) || rhs->IsLong()));
   if (Get() < rhs->AsLong()->Get())
     return -1;
   else if (Get() > rhs->AsLong()->Get())
@@ -313,6 +356,8 @@ auto Long::Compare(Object* rhs) const -> int {
 }
 
 auto Long::Equals(Object* rhs) const -> bool {
+  if (gel::IsSmi(rhs))
+    return Get() == SmiValue(rhs);
   if (!rhs || !rhs->IsLong())
     return false;
   const auto other = rhs->AsLong();
@@ -367,6 +412,11 @@ auto Pair::VisitPointers(PointerVisitor* vis) -> bool {
   return false;
 }
 
+auto Pair::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return VisitPointer(vis, &car_) && VisitPointer(vis, &cdr_);
+}
+
 auto Pair::Equals(Object* rhs) const -> bool {
   if (!rhs->IsPair())
     return false;
@@ -381,11 +431,12 @@ auto Pair::ToString() const -> std::string {
   return helper;
 }
 
-static Pair* kEmptyPair = nullptr;
+static Pair* kEmptyPair = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 auto Pair::Empty() -> Pair* {
   if (kEmptyPair)
     return kEmptyPair;
-  return kEmptyPair = Pair::NewEmpty();
+  kEmptyPair = ::new ((void*)ImmortalSpace::Allocate(sizeof(Pair))) Pair();  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  return kEmptyPair;
 }
 
 auto Pair::HashCode() const -> uword {
@@ -410,10 +461,28 @@ auto StringObject::Equals(const std::string& rhs) const -> bool {
   return Get().compare(rhs) == 0;
 }
 
+static String* kEmptyString = nullptr;                                 // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::array<String*, String::kNumberOfCharacters> kCharacters{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void String::Init() {
+  InitClass();
+  for (uword idx = 0; idx < kNumberOfCharacters; idx++) {
+    const auto address = ImmortalSpace::Allocate(sizeof(String));
+    kCharacters[idx] = ::new ((void*)address) String(std::string(1, static_cast<char>(idx)));  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  }
+}
+
 auto String::New() -> String* {
-  static auto kEmptyString = new String();
-  ASSERT(kEmptyString);
-  return kEmptyString;
+  return Empty();
+}
+
+auto String::New(const std::string& value) -> String* {
+  if (value.empty())
+    return Empty();
+  const auto idx = static_cast<uword>(static_cast<unsigned char>(value[0]));
+  if (value.length() == 1 && idx < kNumberOfCharacters && kCharacters[idx])  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    return kCharacters[idx];                                                  // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+  return new String(value);
 }
 
 auto String::New(Symbol* rhs) -> String* {
@@ -454,9 +523,10 @@ auto String::ToString() const -> std::string {
 }
 
 auto String::Empty() -> String* {
-  static String* kEmpty = String::New();
-  ASSERT(kEmpty);
-  return kEmpty;
+  if (kEmptyString)
+    return kEmptyString;
+  kEmptyString = ::new ((void*)ImmortalSpace::Allocate(sizeof(String))) String();  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  return kEmptyString;
 }
 
 auto String::ValueOf(Object* rhs) -> String* {
@@ -524,6 +594,16 @@ auto Set::Equals(Object* rhs) const -> bool {
   return false;
 }
 
+// the elements are hashed by value, so a moved element stays in its bucket & is written back in place.
+auto Set::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  for (const auto& value : (*data_)) {
+    if (!VisitPointer(vis, const_cast<Object**>(&value)))  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      return false;
+  }
+  return true;
+}
+
 auto Set::ToString() const -> std::string {
   ToStringHelper<Set> helper;
   helper.AddField("size", GetSize());
@@ -563,6 +643,14 @@ auto Set::New(const ObjectList& args) -> Set* {
   return Of(data);
 }
 
+auto Set::Empty() -> Set* {
+  static Set* kEmpty = nullptr;
+  if (kEmpty)
+    return kEmpty;
+  kEmpty = ::new ((void*)ImmortalSpace::Allocate(sizeof(Set))) Set(StorageType{});  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  return kEmpty;
+}
+
 auto Set::CreateClass() -> Class* {
   ASSERT(kClass == nullptr);
   return Class::New(Seq::GetClass(), "Set");
@@ -588,6 +676,16 @@ auto Map::Equals(Object* rhs) const -> bool {
   return false;
 }
 
+// the keys are hashed by value, so a moved key stays in its bucket & is written back in place.
+auto Map::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  for (auto& [key, value] : (*data_)) {
+    if (!VisitPointer(vis, const_cast<Object**>(&key)) || !VisitPointer(vis, &value))  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      return false;
+  }
+  return true;
+}
+
 auto Map::ToString() const -> std::string {
   ToStringHelper<Map> helper;
   helper.AddField("size", GetSize());
@@ -609,6 +707,14 @@ auto Map::New(const ObjectList& args) -> Map* {
   return Map::New(data);
 }
 
+auto Map::Empty() -> Map* {
+  static Map* kEmpty = nullptr;
+  if (kEmpty)
+    return kEmpty;
+  kEmpty = ::new ((void*)ImmortalSpace::Allocate(sizeof(Map))) Map(StorageType{});  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  return kEmpty;
+}
+
 auto Map::CreateClass() -> Class* {
   ASSERT(kClass == nullptr);
   return Class::New(Seq::GetClass(), "Map");
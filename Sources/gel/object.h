@@ -5,6 +5,7 @@
 
 #include <exception>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <ostream>
 #include <ranges>
@@ -17,6 +18,8 @@
 #include <utility>
 
 #include "gel/common.h"
+#include "gel/heap.h"
+#include "gel/immortal_space.h"
 #include "gel/platform.h"
 #include "gel/pointer.h"
 #include "gel/rx.h"
@@ -58,14 +61,91 @@ class Object {
     seed ^= hasher(rhs) + 0x9e3779b9 + (seed << 6) + (seed >> 2);  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
   }
 
+  // weak references aren't visited by VisitPointers, so they don't keep their referents alive. the collectors only
+  // visit them once tracing is done, see WeakRef & WeakMap.
+  virtual auto VisitWeakPointers(PointerPointerVisitor* vis) -> bool {
+    ASSERT(vis);
+    // do nothing
+    return true;
+  }
+
+  // clears the weak references w/ a dead referent, `is_alive` updates a reference in case its referent moved.
+  virtual void ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) {
+    // do nothing
+  }
+
+  // visits the values of the ephemerons w/ a live key, called until the collector stops finding new survivors.
+  virtual auto VisitEphemerons(const std::function<bool(Pointer**)>& is_alive, PointerPointerVisitor* vis) -> bool {
+    ASSERT(vis);
+    // do nothing
+    return true;
+  }
+
   auto FieldAddrAtOffset(const uword offset) const -> Object** {
     const auto address = ((uword)this) + offset;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
     return ((Object**)address);                   // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
   }
 
   auto FieldAddr(Field* field) const -> Object**;
+  // visits the instance fields laid out by the Class, see Class::Finalize.
+  auto VisitFieldPointers(PointerPointerVisitor* vis) -> bool;
+
+  inline void WriteBarrier(Object* value) const {
+    if (value)
+      gel::WriteBarrier(raw_ptr(), value->raw_ptr());
+  }
+
+  // the collector moves Objects w/o running their constructors, so native values that aren't trivially relocatable
+  // (e.g. std::string, std::set) must live off-heap, owned by the Object. Objects that own off-heap storage register
+  // here to have their destructor run once they're collected.
+  inline void RegisterFinalizer() const {
+#ifndef GEL_DISABLE_HEAP
+    gel::RegisterFinalizer(raw_ptr());
+#endif  // GEL_DISABLE_HEAP
+  }
+
+  // Objects w/ weak references register here to have them cleared once their referents are collected.
+  inline void RegisterWeakPointers() const {
+#ifndef GEL_DISABLE_HEAP
+    gel::RegisterWeakPointers(raw_ptr());
+#endif  // GEL_DISABLE_HEAP
+  }
+
+  static inline void PreWriteBarrier(Object* old_value) {
+    if (Heap::IsMarking() && old_value)
+      gel::PreWriteBarrier(old_value->raw_ptr());
+  }
+
+  // visits the Pointer behind an Object* field & writes it back in case the visitor moved it.
+  template <class T>
+  static inline auto VisitPointer(PointerPointerVisitor* vis, T** field) -> bool {
+    ASSERT(vis && field);
+    if (!(*field))
+      return true;
+    const auto old_ptr = (*field)->raw_ptr();
+    auto ptr = old_ptr;
+    if (!vis->Visit(&ptr))
+      return false;
+    // the concurrent marker never moves a Pointer, so it must not race the mutator by writing the field back
+    if (ptr != old_ptr)
+      (*field) = ptr->template As<T>();
+    return true;
+  }
 
  public:
+  // visits the Pointer behind an off-heap Object* slot (e.g. a stack value) & writes it back in case the visitor moved it.
+  template <class T>
+  static inline auto VisitPointer(const std::function<bool(Pointer**)>& vis, T** slot) -> bool {
+    ASSERT(slot);
+    if (!(*slot))
+      return true;
+    auto ptr = (*slot)->raw_ptr();
+    if (!vis(&ptr))
+      return false;
+    (*slot) = ptr->template As<T>();
+    return true;
+  }
+
   virtual ~Object() = default;
   virtual auto GetType() const -> Class* = 0;
   virtual auto HashCode() const -> uword = 0;
@@ -80,13 +160,21 @@ class Object {
   virtual auto Or(Object* rhs) const -> Object*;
   virtual auto Compare(Object* rhs) const -> int;
 
+  // true if VisitPointers walks off-heap containers the mutator may resize (e.g. a LocalScope), the concurrent marker
+  // only visits these Objects while the mutator is stopped.
+  virtual auto HasOffHeapPointers() const -> bool {
+    return false;
+  }
+
   auto GetField(Field* field) const -> Object* {
     ASSERT(field);
     return (*FieldAddr(field));
   }
 
   void SetField(Field* field, Object* rhs) {
+    PreWriteBarrier(GetField(field));
     (*FieldAddr(field)) = rhs;
+    WriteBarrier(rhs);
   }
 
   auto raw_ptr() const -> Pointer*;
@@ -141,16 +229,11 @@ class Object {
 };
 
 struct ObjectHasher {
-  auto operator()(Object* rhs) const -> size_t {
-    ASSERT(rhs);
-    return rhs->HashCode();
-  }
+  inline auto operator()(Object* rhs) const -> size_t;
 };
 
 struct ObjectComparator {
-  auto operator()(Object* lhs, Object* rhs) const -> bool {
-    return lhs->Equals(rhs);
-  }
+  inline auto operator()(Object* lhs, Object* rhs) const -> bool;
 };
 
 namespace ir {
@@ -304,14 +387,6 @@ class Bool : public Object {
  public:
   static auto New(const bool value) -> Bool*;
 
-  static inline auto NewTrue() -> Bool* {
-    return New(true);
-  }
-
-  static inline auto NewFalse() -> Bool* {
-    return New(false);
-  }
-
   static auto True() -> Bool*;
   static auto False() -> Bool*;
 
@@ -363,6 +438,26 @@ class Number : public Object {
 };
 
 class Long : public Number {
+ public:
+  // small integers (Smis) are canonical Longs in a table in the ImmortalSpace. Object* stays a plain pointer that can be
+  // dereferenced, so a Smi is recognized by its address instead of a tag bit.
+  static constexpr const int64_t kMinSmiValue = -128;
+  static constexpr const int64_t kMaxSmiValue = 16383;
+  static constexpr const uword kNumberOfSmis = kMaxSmiValue - kMinSmiValue + 1;
+  static constexpr const uword kSmiSize = sizeof(Pointer) + sizeof(Number);  // Long doesn't add any fields
+
+ private:
+  static uword kSmiTable;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  static void Init();
+  static void InitSmis();
+
+  static inline auto Smi(const uint64_t value) -> Long* {
+    ASSERT(kSmiTable != UNALLOCATED);
+    const auto idx = value - static_cast<uint64_t>(kMinSmiValue);
+    return Pointer::At(kSmiTable + (idx * kSmiSize))->As<Long>();
+  }
+
  protected:
   explicit Long(const uint64_t value) :
     Number(value) {}
@@ -383,13 +478,39 @@ class Long : public Number {
   DECLARE_TYPE(Long);
 
  public:
+  static inline auto IsSmi(const Object* rhs) -> bool {
+    const auto address = (uword)rhs;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    return rhs && address >= kSmiTable && address < (kSmiTable + (kNumberOfSmis * kSmiSize));
+  }
+
+  static inline auto IsSmiValue(const uint64_t value) -> bool {
+    return (value - static_cast<uint64_t>(kMinSmiValue)) < kNumberOfSmis;
+  }
+
   static inline auto New(const uintptr_t value) -> Long* {
+    if (IsSmiValue(value))
+      return Smi(value);
     return new Long(value);
   }
 
   static auto Unbox(Object* rhs) -> uint64_t;
 };
 
+// true if `rhs` is a canonical Object in the ImmortalSpace, these are never moved or collected.
+static inline auto IsImmortal(Object* rhs) -> bool {
+  return rhs && ImmortalSpace::Contains(rhs->GetStartingAddress());
+}
+
+// true if `rhs` is a canonical small integer.
+static inline auto IsSmi(Object* rhs) -> bool {
+  return Long::IsSmi(rhs);
+}
+
+static inline auto SmiValue(Object* rhs) -> uint64_t {
+  ASSERT(IsSmi(rhs));
+  return static_cast<Long*>(rhs)->Get();
+}
+
 class Double : public Number {
  protected:
   Double(const double value) :
@@ -426,6 +547,7 @@ class Pair : public Seq {
     cdr_(cdr) {}
 
   auto VisitPointers(PointerVisitor* vis) -> bool override;
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
  public:
   ~Pair() override = default;
@@ -440,7 +562,9 @@ class Pair : public Seq {
 
   void SetCar(Object* rhs) {
     ASSERT(rhs);
+    PreWriteBarrier(car_);
     car_ = rhs;
+    WriteBarrier(rhs);
   }
 
   auto GetCdr() const -> Object* {
@@ -453,7 +577,9 @@ class Pair : public Seq {
 
   void SetCdr(Object* rhs) {
     ASSERT(rhs);
+    PreWriteBarrier(cdr_);
     cdr_ = rhs;
+    WriteBarrier(rhs);
   }
 
   auto IsEmpty() const -> bool override {
@@ -467,6 +593,7 @@ class Pair : public Seq {
   DECLARE_TYPE(Pair);
 
  public:
+  // the canonical empty list, see Null(). use NewEmpty for an empty Pair that's mutated afterwards.
   static auto Empty() -> Pair*;
   static inline auto NewEmpty() -> Pair* {
     return new Pair();
@@ -480,27 +607,28 @@ class StringObject : public Object {
   DEFINE_NON_COPYABLE_TYPE(StringObject);
 
  private:
-  std::string value_;
+  std::unique_ptr<std::string> value_;  // off-heap, the small string buffer would dangle once the collector moves it
 
  protected:
-  StringObject() = default;
-  explicit StringObject(std::string value) :
+  explicit StringObject(std::string value = "") :
     Object(),
-    value_(std::move(value)) {}
+    value_(std::make_unique<std::string>(std::move(value))) {
+    RegisterFinalizer();
+  }
 
   inline void Set(const std::string& value) {
-    value_ = value;
+    (*value_) = value;
   }
 
  public:
   ~StringObject() override = default;
 
   auto Get() const -> const std::string& {
-    return value_;
+    return (*value_);
   }
 
   inline auto IsEmpty() const -> bool {
-    return value_.empty();
+    return value_->empty();
   }
 
   auto HashCode() const -> uword override;
@@ -520,12 +648,16 @@ class String : public StringObject {
   auto Equals(const std::string& rhs) const -> bool;
   DECLARE_TYPE(String);
 
+ private:
+  static void Init();
+
  public:
+  // the empty String & the single character Strings below kNumberOfCharacters are canonical.
+  static constexpr const uword kNumberOfCharacters = 128;
+
   static auto New() -> String*;
   static auto New(Symbol* rhs) -> String*;
-  static inline auto New(const std::string& value) -> String* {
-    return new String(value);
-  }
+  static auto New(const std::string& value) -> String*;
   static inline auto Unbox(Object* rhs) -> const std::string& {
     ASSERT(rhs && rhs->IsString());
     return rhs->AsString()->Get();
@@ -540,22 +672,30 @@ class Set : public Object {
   using StorageType = std::unordered_set<Object*, ObjectHasher, ObjectComparator>;
 
  private:
-  StorageType data_;
+  std::unique_ptr<StorageType> data_;  // off-heap, the buckets point back into the container
 
  protected:
   Set(const StorageType& data) :
     Object(),
-    data_(data) {}
+    data_(std::make_unique<StorageType>(data)) {
+    RegisterFinalizer();
+  }
 
   inline auto Find(Object* rhs) const -> StorageType::const_iterator {
     return data().find(rhs);
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~Set() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto data() const -> const StorageType& {
-    return data_;
+    return (*data_);
   }
 
   auto GetSize() const -> uword {
@@ -576,12 +716,12 @@ class Set : public Object {
  public:
   static auto Of(Object* value) -> Set*;
   static inline auto Of(const StorageType& data = {}) -> Set* {
+    if (data.empty())
+      return Empty();
     return new Set(data);
   }
 
-  static inline auto Empty() -> Set* {
-    return Of();
-  }
+  static auto Empty() -> Set*;
 };
 
 class Map : public Object {
@@ -591,29 +731,38 @@ class Map : public Object {
   using ConstIter = StorageType::const_iterator;
 
  private:
-  StorageType data_;
+  std::unique_ptr<StorageType> data_;  // off-heap, the buckets point back into the container
 
   explicit Map(const StorageType& data) :
     Object(),
-    data_(data) {}
+    data_(std::make_unique<StorageType>(data)) {
+    RegisterFinalizer();
+  }
 
   inline auto Find(Object* rhs) const -> ConstIter {
     return data().find(rhs);
   }
 
+ protected:
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~Map() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto data() const -> const StorageType& {
-    return data_;
+    return (*data_);
   }
 
   auto GetSize() const -> uword {
-    return data_.size();
+    return data().size();
   }
 
   auto IsEmpty() const -> bool {
-    return data_.empty();
+    return data().empty();
   }
 
   auto Contains(Object* rhs) const -> bool {
@@ -625,10 +774,27 @@ class Map : public Object {
 
  public:
   static inline auto New(const StorageType& data = {}) -> Map* {
+    if (data.empty())
+      return Empty();
     return new Map(data);
   }
+
+  static auto Empty() -> Map*;
 };
 
+inline auto ObjectHasher::operator()(Object* rhs) const -> size_t {
+  ASSERT(rhs);
+  if (IsSmi(rhs))
+    return static_cast<Long*>(rhs)->Long::HashCode();
+  return rhs->HashCode();
+}
+
+inline auto ObjectComparator::operator()(Object* lhs, Object* rhs) const -> bool {
+  if (IsSmi(lhs) && IsSmi(rhs))
+    return lhs == rhs;
+  return lhs->Equals(rhs);
+}
+
 auto PrintValue(std::ostream& stream, Object* value) -> std::ostream&;
 
 #define DEFINE_TYPE_PRED(Name)                     \
@@ -729,6 +895,8 @@ static inline auto Cdr(Object* rhs) -> Object* {
 
 static inline auto Truth(gel::Object* rhs) -> bool {
   ASSERT(rhs);
+  if (IsSmi(rhs))
+    return true;
   if (rhs->IsBool())
     return rhs->AsBool()->Get();
   return !IsNull(rhs);
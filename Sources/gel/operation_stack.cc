@@ -0,0 +1,51 @@
+#include "gel/operation_stack.h"
+
+#include <fmt/format.h>
+
+namespace gel {
+DEFINE_uword(operation_stack_size, 16 * 1024 * 1024,
+             "The maximum number of slots in the Runtime's OperationStack, they're reserved up front & committed as the "
+             "stack grows.");
+
+OperationStack::OperationStack(const uword capacity) :
+  region_(RoundUp(std::max(capacity, kInitialCommitSize) * sizeof(Slot), MemoryRegion::GetPageSize())),
+  slots_((Slot*)region_.GetStartingAddressPointer()),  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  base_(slots_),
+  top_(slots_),
+  limit_(slots_) {
+  Grow();
+}
+
+OperationStack::~OperationStack() {
+  region_.FreeRegion();
+}
+
+void OperationStack::Grow() {
+  const auto committed = GetCommittedCapacity();
+  if (committed == GetCapacity())
+    throw Exception(fmt::format("operation stack overflow, capacity: {}", GetCapacity()));
+  // doubles the committed slots, the pages are zeroed by the OS
+  const auto num_slots = std::min(std::max(committed * 2, kInitialCommitSize), GetCapacity());
+  region_.Protect(0, num_slots * sizeof(Slot), MemoryRegion::kReadWrite);
+  limit_ = slots_ + num_slots;
+  DVLOG(1000) << "committed " << num_slots << "/" << GetCapacity() << " operation stack slots.";
+}
+
+auto OperationStack::VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool {
+  for (auto slot_ptr = slots_; slot_ptr < top_; slot_ptr++) {
+    auto& slot = (*slot_ptr);
+#ifdef GEL_ENABLE_NAN_BOXING
+    if (!slot.IsObject())
+      continue;
+    auto value = slot.GetObject();
+    if (!Object::VisitPointer(vis, &value))
+      return false;
+    slot = NanBox::Of(value);
+#else
+    if (!Object::VisitPointer(vis, &slot))
+      return false;
+#endif  // GEL_ENABLE_NAN_BOXING
+  }
+  return true;
+}
+}  // namespace gel
@@ -1,72 +1,203 @@
 #ifndef GEL_OPERATION_STACK_H
 #define GEL_OPERATION_STACK_H
 
-#include <stack>
+#include <algorithm>
+#include <vector>
 
 #include "gel/common.h"
+#include "gel/flags.h"
+#include "gel/memory_region.h"
+#include "gel/nan_box.h"
 #include "gel/object.h"
+#include "gel/platform.h"
 
 namespace gel {
+DECLARE_uword(operation_stack_size);
 
+static inline auto GetOperationStackSize() -> uword {
+  return FLAGS_operation_stack_size;
+}
+
+// the Runtime's operand stack, one contiguous array of slots shared by every StackFrame. a frame only sees the slots
+// above its base, pushing & popping are pointer bumps & entering/leaving a frame moves the base.
+// the slots are reserved up front & committed as the stack grows, so they never move. overflowing the reservation
+// throws an Exception.
 class OperationStack {
+  friend class OperationStackTest;
   friend class Runtime;
   friend class StackFrame;
   friend class Interpreter;
-  DEFINE_DEFAULT_COPYABLE_TYPE(OperationStack);
+  DEFINE_NON_COPYABLE_TYPE(OperationStack);
 
  public:
   using Value = Object*;
-  using ValueStack = std::stack<Value>;
+#ifdef GEL_ENABLE_NAN_BOXING
+  // numbers are kept unboxed until they're popped as an Object*, see NanBox.
+  using Slot = NanBox;
+#else
+  using Slot = Object*;
+#endif  // GEL_ENABLE_NAN_BOXING
   using OptionalValue = std::optional<Value>;
 
+  static constexpr const uword kInitialCommitSize = 64 * 1024;  // in slots
+
  private:
-  ValueStack stack_{};
+  MemoryRegion region_;
+  Slot* slots_;
+  Slot* base_;
+  Slot* top_;
+  Slot* limit_;             // the end of the committed slots
+  Slot* locals_ = nullptr;  // the current frame's local slots, right below its base
+
+  // commits more of the reservation once the committed slots are used up.
+  void Grow();
+
+  inline void EnsureCapacity() {
+    if (top_ == limit_)
+      Grow();
+  }
+
+  static inline auto ToValue(const Slot& slot) -> Value {
+#ifdef GEL_ENABLE_NAN_BOXING
+    return slot.Box();
+#else
+    return slot;
+#endif  // GEL_ENABLE_NAN_BOXING
+  }
+
+  // boxes `slot` in place, the result stays rooted by the stack while the caller allocates more.
+  static inline auto BoxInPlace(Slot& slot) -> Value {
+#ifdef GEL_ENABLE_NAN_BOXING
+    if (!slot.IsObject())
+      slot = NanBox::Of(slot.Box());
+#endif  // GEL_ENABLE_NAN_BOXING
+    return ToValue(slot);
+  }
+
+  static inline auto IsObjectSlot(const Slot& slot) -> bool {
+#ifdef GEL_ENABLE_NAN_BOXING
+    return slot.IsObject();
+#else
+    return true;
+#endif  // GEL_ENABLE_NAN_BOXING
+  }
+
+  static inline auto ToSlot(Value value) -> Slot {
+#ifdef GEL_ENABLE_NAN_BOXING
+    return NanBox::Of(value);
+#else
+    return value;
+#endif  // GEL_ENABLE_NAN_BOXING
+  }
 
  protected:
-  OperationStack() = default;
+  // `capacity` is the maximum number of slots.
+  explicit OperationStack(const uword capacity = GetOperationStackSize());
+
+  // the index of the current frame's first slot.
+  inline auto GetBase() const -> uword {
+    return base_ - slots_;
+  }
+
+  inline void SetBase(const uword base, const uword num_locals = 0) {
+    ASSERT(num_locals <= base && base <= GetHeight());
+    base_ = slots_ + base;
+    locals_ = num_locals > 0 ? base_ - num_locals : nullptr;
+  }
+
+  // the number of slots in use by every frame.
+  inline auto GetHeight() const -> uword {
+    return top_ - slots_;
+  }
+
+  // drops every slot at or above `height`.
+  inline void Truncate(const uword height) {
+    ASSERT(height <= GetHeight());
+    top_ = slots_ + height;
+  }
+
+  // moves the top `num` slots up by one to make room for `value` below them.
+  inline void Insert(const uword num, Value value) {
+    ASSERT(value);
+    ASSERT(num <= GetStackSize());
+    EnsureCapacity();
+    std::copy_backward(top_ - num, top_, top_ + 1);
+    *(top_ - num) = ToSlot(value);
+    top_++;
+  }
+
+  // moves the top `num` slots down to `height`, the slots in between are dropped.
+  inline void Drop(const uword height, const uword num) {
+    ASSERT(height + num <= GetHeight());
+    const auto dst = slots_ + height;
+    std::copy(top_ - num, top_, dst);
+    top_ = dst + num;
+  }
+
+  inline auto HasLocals() const -> bool {
+    return locals_ != nullptr;
+  }
+
+  inline void LoadLocal(const uword idx) {
+    ASSERT(HasLocals() && (locals_ + idx) < base_);
+    PushSlot(locals_[idx]);
+  }
+
+  inline void StoreLocal(const uword idx) {
+    ASSERT(HasLocals() && (locals_ + idx) < base_);
+    locals_[idx] = PopSlot();
+  }
 
  public:
-  virtual ~OperationStack() = default;
+  virtual ~OperationStack();
 
-  auto data() const -> const ValueStack& {
-    return stack_;
+  // the maximum number of slots.
+  auto GetCapacity() const -> uword {
+    return region_.GetSize() / sizeof(Slot);
+  }
+
+  // the number of slots backed by memory so far.
+  auto GetCommittedCapacity() const -> uword {
+    return limit_ - slots_;
   }
 
   auto GetTop() const -> OptionalValue {
-    if (stack_.empty())
+    if (IsEmpty())
       return std::nullopt;
-    return {stack_.top()};
+    return {top()};
   }
 
-  auto top() const -> const Value& {
-    return stack_.top();
+  // boxes the top slot in place, so repeated calls don't allocate another Object.
+  auto top() const -> Value {
+    ASSERT(!IsEmpty());
+    return BoxInPlace(*(top_ - 1));
   }
 
   auto IsEmpty() const -> bool {
-    return stack_.empty();
+    return top_ == base_;
   }
 
   auto GetStackSize() const -> uint64_t {
-    return stack_.size();
+    return top_ - base_;
   }
 
   auto GetError() const -> Error* {
     ASSERT(HasError());
-    return stack_.top()->AsError();
+    return top()->AsError();
   }
 
   inline auto HasError() const -> bool {
-    if (stack_.empty())
+    if (IsEmpty())
       return false;
-    return stack_.top()->IsError();
+    const auto& slot = *(top_ - 1);
+    return IsObjectSlot(slot) && ToValue(slot)->IsError();
   }
 
   auto Pop() -> OptionalValue {
-    if (stack_.empty())
+    if (IsEmpty())
       return std::nullopt;
-    const auto next = stack_.top();
+    const auto next = ToValue(*(--top_));
     ASSERT(next);
-    stack_.pop();
     return {next};
   }
 
@@ -78,16 +209,38 @@ class OperationStack {
 
   void Push(Value value) {
     ASSERT(value);
-    stack_.push(value);
+    EnsureCapacity();
+    *(top_++) = ToSlot(value);
+  }
+
+  // pops the top of the stack w/o boxing it.
+  inline auto PopSlot() -> Slot {
+    ASSERT(!IsEmpty());
+    return *(--top_);
+  }
+
+  inline void PushSlot(const Slot& slot) {
+    EnsureCapacity();
+    *(top_++) = slot;
+  }
+
+  // boxes the top `num` slots in place, the Objects boxed first stay rooted while the rest allocate.
+  inline void BoxTop(const uword num) {
+    ASSERT(num <= GetStackSize());
+    for (auto slot = top_ - num; slot < top_; slot++)
+      BoxInPlace(*slot);
   }
 
   inline void PopN(std::vector<Value>& result, const uword num, const bool reverse = false) {
+    BoxTop(std::min<uword>(num, GetStackSize()));
     for (auto idx = 0; idx < num; idx++) {
       result.push_back(PopOr(Null()));
     }
     if (reverse)
       std::ranges::reverse(std::begin(result), std::end(result));
   }
+
+  auto VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool;
 };
 }  // namespace gel
 
@@ -5,6 +5,22 @@
 namespace gel {
 auto Pointer::VisitPointers(PointerPointerVisitor* vis) -> bool {
   ASSERT(vis);
-  return GetObjectPointer()->VisitPointers(vis);
+  const auto value = GetObjectPointer();
+  ASSERT(value);
+  return value->VisitPointers(vis) && value->VisitFieldPointers(vis);
+}
+
+auto Pointer::VisitWeakPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return GetObjectPointer()->VisitWeakPointers(vis);
+}
+
+void Pointer::ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) {
+  return GetObjectPointer()->ClearWeakPointers(is_alive);
+}
+
+auto Pointer::VisitEphemerons(const std::function<bool(Pointer**)>& is_alive, PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return GetObjectPointer()->VisitEphemerons(is_alive, vis);
 }
 }  // namespace gel
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef GEL_POINTER_H
 #define GEL_POINTER_H
 
+#include <atomic>
+#include <functional>
+
 #include "gel/common.h"
 #include "gel/platform.h"
 #include "gel/tag.h"
@@ -45,8 +48,19 @@ class Object;
 class Pointer {
   friend class NewZone;
   friend class OldZone;
+  friend class LargeObjectSpace;
+  friend class FreeList;
+  friend class Heap;
+  friend class LocalAllocationBuffer;
   friend class Collector;
-  friend class PointerNotifier;
+  friend class ScavengerWorker;
+  friend class Marker;
+  friend class ConcurrentMarker;
+  friend class Sweeper;
+  friend class Compactor;
+  friend class HeapSnapshot;
+  friend class HeapVerifier;
+  friend class ImmortalSpace;
   DEFINE_NON_COPYABLE_TYPE(Pointer);
 
  private:
@@ -60,6 +74,21 @@ class Pointer {
     forwarding_ = address;
   }
 
+  // installs `address` as the forwarding address unless another thread forwarded this Pointer first, returns the
+  // winning forwarding address.
+  auto TryForward(const uword address) -> uword {
+    uword expected = UNALLOCATED;
+    std::atomic_ref<uword> forwarding(forwarding_);
+    if (forwarding.compare_exchange_strong(expected, address, std::memory_order_acq_rel, std::memory_order_acquire))
+      return address;
+    return expected;
+  }
+
+  auto LoadForwardingAddress() const -> uword {
+    auto& forwarding = const_cast<uword&>(forwarding_);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    return std::atomic_ref<uword>(forwarding).load(std::memory_order_acquire);
+  }
+
   void SetTag(const Tag& rhs) {
     tag_ = rhs;
   }
@@ -74,6 +103,9 @@ class Pointer {
 
  protected:
   auto VisitPointers(PointerPointerVisitor* vis) -> bool;
+  auto VisitWeakPointers(PointerPointerVisitor* vis) -> bool;
+  void ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive);
+  auto VisitEphemerons(const std::function<bool(Pointer**)>& is_alive, PointerPointerVisitor* vis) -> bool;
 
  public:
   ~Pointer() = default;
@@ -167,6 +199,33 @@ class Pointer {
 };
 
 using PointerList = std::vector<Pointer*>;
+
+void RememberPointer(Pointer* ptr);
+void RememberSlot(Pointer** slot);
+void RememberOverwritten(Pointer* ptr);
+void RegisterFinalizer(Pointer* ptr);
+void RegisterWeakPointers(Pointer* ptr);
+
+// write barrier for storing `value` into the heap allocated `holder`, records old -> new references in the remembered set.
+static inline void WriteBarrier(Pointer* holder, Pointer* value) {
+#ifndef GEL_DISABLE_HEAP
+  ASSERT(holder);
+  if (IsUnallocated(value))
+    return;
+  const auto& tag = holder->GetTag();
+  if (tag.IsOld() && !tag.IsRemembered() && value->GetTag().IsNew())
+    RememberPointer(holder);
+#endif  // GEL_DISABLE_HEAP
+}
+
+// write barrier for off-heap slots (e.g. LocalVariables) that aren't visited by every minor collection.
+static inline void WriteBarrier(Pointer** slot) {
+#ifndef GEL_DISABLE_HEAP
+  ASSERT(slot);
+  if (!IsUnallocated(*slot) && (*slot)->GetTag().IsNew())
+    RememberSlot(slot);
+#endif  // GEL_DISABLE_HEAP
+}
 }  // namespace gel
 
 #endif  // GEL_POINTER_H
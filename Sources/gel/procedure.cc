@@ -6,6 +6,11 @@
 #include "gel/runtime.h"
 
 namespace gel {
+auto Procedure::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return VisitPointer(vis, &symbol_);
+}
+
 auto Procedure::CreateClass() -> Class* {
   return Class::New(Object::GetClass(), "Procedure");
 }
@@ -29,6 +29,8 @@ class Procedure : public Object {
     symbol_ = nullptr;
   }
 
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
+
  public:
   ~Procedure() override = default;
 
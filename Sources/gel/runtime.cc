@@ -6,9 +6,9 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <ranges>
 #include <unordered_set>
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/error.h"
 #include "gel/expression.h"
@@ -30,6 +30,7 @@
 #include "gel/stack_frame.h"
 #include "gel/thread_local.h"
 #include "gel/tracing.h"
+#include "gel/util.h"
 
 namespace gel {
 DEFINE_bool(kernel, true, "Load the kernel at boot.");
@@ -54,6 +55,7 @@ Runtime::Runtime(LocalScope* scope) :
   interpreter_(this) {
   ASSERT(init_scope_);
   ASSERT(curr_scope_);
+  frames_.reserve(kInitialNumberOfStackFrames);
 }
 
 namespace fs = std::filesystem;
@@ -106,49 +108,81 @@ auto Runtime::CreateInitScope() -> LocalScope* {
   return scope;
 }
 
-void Runtime::Call(Lambda* lambda, const ObjectList& args) {
+// the arguments are the top `num_args` slots of the caller's OperationStack, they're moved up a slot to make room for
+// the Lambda & become the first slots of its frame. the rest of the Lambda's locals are padded w/ '(), so a call only
+// bumps the OperationStack.
+void Runtime::PushLocals(Lambda* lambda, const uword num_args) {
+  ASSERT(lambda && lambda->IsCompiled());
+  ASSERT(num_args <= lambda->GetNumberOfArgs());
+  if (num_args < lambda->GetNumberOfArgs()) {
+    for (const auto& arg : lambda->GetArgs()) {
+      LOG_IF(FATAL, arg.GetIndex() >= num_args && !arg.IsOptional() && !arg.IsVararg()) << arg << " is not optional.";
+    }
+  }
+  const auto num_locals = lambda->GetNumberOfLocals();
+  ASSERT(num_locals > lambda->GetNumberOfArgs());
+  operands_.Insert(num_args, lambda);
+  for (auto idx = num_args + 1; idx < num_locals; idx++) {
+    operands_.Push(Null());
+  }
+}
+
+void Runtime::CallWithNArgs(Lambda* lambda, const uword num_args) {
   ASSERT(lambda);
-  const auto locals = PushScope();
-  ASSERT(locals);
-  const auto self_local = LocalVariable::New(locals, lambda->HasSymbol() ? lambda->GetSymbol() : Symbol::New("$"), lambda);
-  ASSERT(self_local);
-  LOG_IF(FATAL, !locals->Add(self_local)) << "failed to add " << (*self_local) << " to scope.";
+  ScopedRoot<Lambda> target(&lambda);
+  if (!lambda->IsCompiled())
+    LOG_IF(FATAL, !FlowGraphCompiler::Compile(lambda, LocalScope::New(GetScope()))) << "failed to compile: " << lambda;
+  PushLocals(lambda, num_args);
+  StackFrameGuard<Lambda> stack_guard(lambda);
   {
-    const auto& lambda_args = lambda->GetArgs();
-    ASSERT(lambda_args.size() == args.size());
-    auto idx = 0;
-    for (const auto& arg : std::ranges::reverse_view(lambda_args)) {
-      const auto symbol = Symbol::New(arg.GetName());
-      ASSERT(symbol);
-      const auto value = args[idx++];
-      ASSERT(value);
-      const auto local = LocalVariable::New(locals, symbol, value);
-      ASSERT(local);
-      LOG_IF(FATAL, !locals->Add(local)) << "failed to add parameter local";
-    }
-    if (!lambda->IsCompiled())
-      LOG_IF(FATAL, !FlowGraphCompiler::Compile(lambda, locals)) << "failed to compile: " << lambda;
-    StackFrameGuard<Lambda> stack_guard(lambda);
-    {
-      PushStackFrame(lambda, locals);
-      interpreter_.Run(lambda->GetCode().GetStartingAddress());
-      const auto frame = PopStackFrame();
-      const auto result = !frame.stack().IsEmpty() ? frame.stack().top() : Null();
-      ASSERT(result);
-      if (!stack_.empty()) {
-        stack_.top().GetOperationStack()->Push(result);
-      } else {
-        result_ = result;
-      }
-      if (frame.HasReturnAddress())
-        interpreter_.SetCurrentAddress(frame.GetReturnAddress());
+    PushStackFrame(lambda, lambda->GetNumberOfLocals());
+    interpreter_.Run(lambda->GetCode().GetStartingAddress());
+    const auto result = !operands_.IsEmpty() ? operands_.top() : Null();
+    ASSERT(result);
+    const auto frame = PopStackFrame();
+    if (!frames_.empty()) {
+      operands_.Push(result);
+    } else {
+      result_ = result;
     }
+    if (frame.HasReturnAddress())
+      interpreter_.SetCurrentAddress(frame.GetReturnAddress());
   }
-  PopScope();
+}
+
+auto Runtime::TailCallWithNArgs(Lambda* lambda, const uword num_args) -> uword {
+  ASSERT(lambda);
+  ASSERT(HasStackFrame() && GetCurrentStackFrame().IsLambdaFrame());
+  ScopedRoot<Lambda> target(&lambda);
+  if (!lambda->IsCompiled())
+    LOG_IF(FATAL, !FlowGraphCompiler::Compile(lambda, LocalScope::New(GetScope()))) << "failed to compile: " << lambda;
+  // the args replace the caller's locals, the frame keeps its id & return address
+  auto& frame = frames_.back();
+  const auto locals_base = frame.GetLocalsBase();
+  operands_.Drop(locals_base, num_args);
+  operands_.SetBase(locals_base);
+  PushLocals(lambda, num_args);
+  frame.target_ = lambda;
+  frame.num_locals_ = lambda->GetNumberOfLocals();
+  frame.base_ = locals_base + frame.num_locals_;
+  operands_.SetBase(frame.GetBase(), frame.GetNumberOfLocals());
+  DVLOG(1000) << "replaced: " << frame;
+  return lambda->GetCode().GetStartingAddress();
+}
+
+void Runtime::Call(Lambda* lambda, const ObjectList& args) {
+  ASSERT(lambda);
+  for (const auto& arg : args) {
+    ASSERT(arg);
+    operands_.Push(arg);
+  }
+  return CallWithNArgs(lambda, args.size());
 }
 
 void Runtime::Call(NativeProcedure* native, const ObjectList& args) {
   ASSERT(native && native->HasEntry());
+  ScopedRoot<NativeProcedure> target(&native);
+  ArgumentsScope arguments(this, args);
   const auto locals = PushScope();
   ASSERT(locals);
   {
@@ -159,11 +193,11 @@ void Runtime::Call(NativeProcedure* native, const ObjectList& args) {
     {
       PushStackFrame(native, locals);
       LOG_IF(FATAL, !native->GetEntry()->Apply(args)) << "failed to apply: " << native->ToString() << " with args: " << args;
-      const auto frame = PopStackFrame();
-      const auto result = !frame.stack().IsEmpty() ? frame.stack().top() : Null();
+      const auto result = !operands_.IsEmpty() ? operands_.top() : Null();
       ASSERT(result);
-      if (!stack_.empty()) {
-        stack_.top().GetOperationStack()->Push(result);
+      const auto frame = PopStackFrame();
+      if (!frames_.empty()) {
+        operands_.Push(result);
       } else {
         result_ = result;
       }
@@ -176,6 +210,8 @@ void Runtime::Call(NativeProcedure* native, const ObjectList& args) {
 
 void Runtime::Call(Script* script, const ObjectList& args) {
   ASSERT(script && script->IsCompiled());
+  ScopedRoot<Script> target(&script);
+  ArgumentsScope arguments(this, args);
   const auto locals = PushScope();
   ASSERT(locals);
   {
@@ -184,11 +220,11 @@ void Runtime::Call(Script* script, const ObjectList& args) {
     {
       PushStackFrame(script, locals);
       interpreter_.Run(script->GetCode().GetStartingAddress());
-      const auto frame = PopStackFrame();
-      const auto result = !frame.stack().IsEmpty() ? frame.stack().top() : Null();
+      const auto result = !operands_.IsEmpty() ? operands_.top() : Null();
       ASSERT(result);
-      if (!stack_.empty()) {
-        stack_.top().GetOperationStack()->Push(result);
+      const auto frame = PopStackFrame();
+      if (!frames_.empty()) {
+        operands_.Push(result);
       } else {
         result_ = result;
       }
@@ -215,8 +251,9 @@ auto Runtime::Eval(const std::string& expr) -> Object* {
   if (parsed)
     lambda->SetBody(parsed);
   LOG_IF(FATAL, !FlowGraphCompiler::Compile(lambda, scope)) << "failed to compile: " << expr;
-  const auto result = runtime->CallPop(lambda);
+  auto result = runtime->CallPop(lambda);
   runtime->PopScope();
+  runtime->DrainEventLoop(&result);
   return result ? result : Null();
 }
 
@@ -224,7 +261,17 @@ auto Runtime::Exec(Script* script) -> Object* {
   ASSERT(script);
   const auto runtime = GetRuntime();
   ASSERT(runtime);
-  return GetRuntime()->CallPop(script);
+  auto result = runtime->CallPop(script);
+  runtime->DrainEventLoop(&result);
+  return result;
+}
+
+void Runtime::DrainEventLoop(Object** result) {
+  ASSERT(result);
+  if (HasStackFrame())  // only finishing a top-level Script or expression is a safepoint
+    return;
+  ScopedRoot<Object> root(result);
+  scheduler_.Drain();
 }
 
 void Runtime::Init() {
@@ -248,42 +295,72 @@ void Runtime::Init() {
 auto Runtime::PushStackFrame(NativeProcedure* native, LocalScope* locals) -> const StackFrame& {
   ASSERT(locals);
   const auto frame_id = HasStackFrame() ? GetCurrentStackFrame().GetId() + 1 : 1;
-  const auto new_frame = StackFrame(frame_id, native, locals, interpreter_.GetCurrentAddress());
-  stack_.push(new_frame);
+  const auto new_frame = StackFrame(frame_id, native, locals, operands_.GetHeight(), 0, interpreter_.GetCurrentAddress());
+  frames_.push_back(new_frame);
+  operands_.SetBase(new_frame.GetBase());
   LOG_IF(ERROR, !new_frame.HasReturnAddress() && frame_id != 1) << "return address empty";
-  DVLOG(1000) << "pushed: " << stack_.top();
-  return stack_.top();
+  DVLOG(1000) << "pushed: " << frames_.back();
+  return frames_.back();
 }
 
 auto Runtime::PushStackFrame(Script* target, LocalScope* locals) -> const StackFrame& {
   ASSERT(target);
   const auto frame_id = HasStackFrame() ? GetCurrentStackFrame().GetId() + 1 : 1;
-  const auto new_frame = StackFrame(frame_id, target, locals, interpreter_.GetCurrentAddress());
-  stack_.push(new_frame);
+  const auto new_frame = StackFrame(frame_id, target, locals, operands_.GetHeight(), 0, interpreter_.GetCurrentAddress());
+  frames_.push_back(new_frame);
+  operands_.SetBase(new_frame.GetBase());
   LOG_IF(ERROR, !new_frame.HasReturnAddress() && frame_id != 1) << "return address empty";
-  DVLOG(1000) << "pushed: " << stack_.top();
-  return stack_.top();
+  DVLOG(1000) << "pushed: " << frames_.back();
+  return frames_.back();
 }
 
-auto Runtime::PushStackFrame(Lambda* target, LocalScope* locals) -> const StackFrame& {
+auto Runtime::PushStackFrame(Lambda* target, const uword num_locals) -> const StackFrame& {
   ASSERT(target);
+  ASSERT(num_locals > 0);
   const auto frame_id = HasStackFrame() ? GetCurrentStackFrame().GetId() + 1 : 1;
   const auto return_address = interpreter_.GetCurrentAddress();
-  const auto new_frame = StackFrame(frame_id, target, locals, return_address);
-  stack_.push(new_frame);
+  const auto new_frame = StackFrame(frame_id, target, GetScope(), operands_.GetHeight(), num_locals, return_address);
+  frames_.push_back(new_frame);
+  operands_.SetBase(new_frame.GetBase(), new_frame.GetNumberOfLocals());
   LOG_IF(ERROR, !new_frame.HasReturnAddress() && frame_id != 1) << "return address empty";
-  DVLOG(1000) << "pushed: " << stack_.top();
-  return stack_.top();
+  DVLOG(1000) << "pushed: " << frames_.back();
+  return frames_.back();
+}
+
+auto Runtime::VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool {
+  for (auto& frame : frames_) {
+    if (!frame.VisitPointers(vis))
+      return false;
+  }
+  if (!operands_.VisitPointers(vis))
+    return false;
+  // every StackFrame's locals are pushed onto the current scope chain, which ends w/ the init scope
+  const auto scope = curr_scope_ ? curr_scope_ : init_scope_;
+  if (scope && !scope->VisitLocalPointers(vis))
+    return false;
+  for (const auto& args : args_) {
+    for (auto& value : (*args)) {
+      if (!Object::VisitPointer(vis, &value))
+        return false;
+    }
+  }
+  return Object::VisitPointer(vis, &result_);
 }
 
 auto Runtime::PopStackFrame() -> StackFrame {
-  if (stack_.empty()) {
+  if (frames_.empty()) {
     DLOG(WARNING) << "stack empty";
     return {};
   }
-  ASSERT(!stack_.empty());
-  const auto frame = stack_.top();
-  stack_.pop();
+  const auto frame = frames_.back();
+  frames_.pop_back();
+  // drops the frame's locals & whatever it left on the OperationStack, then hands it back to the caller's frame
+  operands_.Truncate(frame.GetLocalsBase());
+  if (!frames_.empty()) {
+    operands_.SetBase(frames_.back().GetBase(), frames_.back().GetNumberOfLocals());
+  } else {
+    operands_.SetBase(0);
+  }
   DVLOG(1000) << "popped: " << frame;
   return frame;
 }
@@ -5,9 +5,9 @@
 
 #include <rpp/observers/dynamic_observer.hpp>
 #include <rpp/sources/fwd.hpp>
-#include <stack>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "gel/common.h"
 #include "gel/error.h"
@@ -19,6 +19,8 @@
 #include "gel/native_procedure.h"
 #include "gel/natives.h"
 #include "gel/object.h"
+#include "gel/operation_stack.h"
+#include "gel/scheduler.h"
 #include "gel/stack_frame.h"
 #include "gel/type_traits.h"
 
@@ -46,13 +48,20 @@ class Runtime {
   friend class NativeProcedure;
   friend class RuntimeScopeScope;
   friend class NativeProcedureEntry;
+  friend class AllocationProfiler;
   DEFINE_NON_COPYABLE_TYPE(Runtime);
 
+ public:
+  static constexpr const uword kInitialNumberOfStackFrames = 1024;
+
  private:
   LocalScope* init_scope_;
   LocalScope* curr_scope_;
   Interpreter interpreter_;
-  std::stack<StackFrame> stack_{};
+  OperationStack operands_{};
+  std::vector<StackFrame> frames_{};
+  Scheduler scheduler_{};
+  std::vector<ObjectList*> args_{};  // the arguments of every in-flight Call
   bool executing_ = false;
   Object* result_ = nullptr;
 
@@ -61,10 +70,14 @@ class Runtime {
   }
 
   inline auto GetOperationStack() -> OperationStack* {
-    ASSERT(!stack_.empty());
-    return stack_.top().GetOperationStack();
+    ASSERT(!frames_.empty());
+    return &operands_;
   }
 
+  void CallWithNArgs(Lambda* lambda, const uword num_args);
+  // replaces the current Lambda frame w/ a frame for `lambda`, returns the address to continue at.
+  auto TailCallWithNArgs(Lambda* lambda, const uword num_args) -> uword;
+
   template <class E>
   inline void CallWithNArgs(E* exec, const uword num_args, std::enable_if_t<gel::is_executable<E>::value>* = nullptr) {
     ASSERT(exec);
@@ -108,6 +121,24 @@ class Runtime {
   void Call(Lambda* lambda, const ObjectList& args = {});
   void Call(Script* script, const ObjectList& args = {});
 
+  // keeps the arguments of an in-flight Call visible to the collector until the callee returns.
+  class ArgumentsScope {
+    DEFINE_NON_COPYABLE_TYPE(ArgumentsScope);
+
+   private:
+    Runtime* runtime_;
+
+   public:
+    ArgumentsScope(Runtime* runtime, const ObjectList& args) :
+      runtime_(runtime) {
+      ASSERT(runtime_);
+      runtime_->args_.push_back(const_cast<ObjectList*>(&args));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+    ~ArgumentsScope() {
+      runtime_->args_.pop_back();
+    }
+  };
+
   inline auto PushScope() -> LocalScope* {
     const auto new_scope = LocalScope::New(curr_scope_);
     curr_scope_ = new_scope;
@@ -120,9 +151,13 @@ class Runtime {
     curr_scope_ = curr_scope_->GetParent();
   }
 
+  // runs the EventLoop until it has no more work, `result` is kept alive while the callbacks run.
+  void DrainEventLoop(Object** result);
+  // moves the top `num_args` operands up to make room for `lambda` & pads the rest of its locals.
+  void PushLocals(Lambda* lambda, const uword num_args);
   auto PopStackFrame() -> StackFrame;
   auto PushStackFrame(Script* script, LocalScope* locals) -> const StackFrame&;
-  auto PushStackFrame(Lambda* lambda, LocalScope* locals) -> const StackFrame&;
+  auto PushStackFrame(Lambda* lambda, const uword num_locals) -> const StackFrame&;
   auto PushStackFrame(NativeProcedure* native, LocalScope* locals) -> const StackFrame&;
 
  public:  // TODO: reduce visibility
@@ -173,20 +208,28 @@ class Runtime {
     return executing_;
   }
 
+  auto GetScheduler() -> Scheduler* {
+    return &scheduler_;
+  }
+
   auto HasStackFrame() const -> bool {
-    return !stack_.empty();
+    return !frames_.empty();
   }
 
   auto GetCurrentStackFrame() const -> const StackFrame& {
-    return stack_.top();
+    ASSERT(!frames_.empty());
+    return frames_.back();
   }
 
+  // visits every StackFrame, the scope chain & the arguments of every in-flight Call.
+  auto VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool;
+
   template <class E>
   inline auto CallPop(E* exec, const ObjectList& args = {}, std::enable_if_t<gel::is_executable<E>::value>* = nullptr)
       -> Object* {
     ASSERT(exec);
     Call(exec, args);
-    if (!stack_.empty())
+    if (!frames_.empty())
       return GetOperationStack()->PopOr(Null());
     const auto result = result_ ? result_ : Null();
     ASSERT(result);
@@ -3,6 +3,7 @@
 #include <exception>
 #include <rpp/operators/map.hpp>
 
+#include "gel/collector.h"
 #include "gel/common.h"
 #include "gel/local_scope.h"
 #include "gel/object.h"
@@ -22,8 +23,8 @@ auto GetRxScope() -> LocalScope* {
 auto CallPredicate(Runtime* runtime, Procedure* predicate) -> Predicate {
   ASSERT(runtime);
   ASSERT(predicate);
-  return [runtime, predicate](gel::Object* value) {
-    return gel::Truth(runtime->CallPop(predicate, {value}));
+  return [runtime, predicate = Persistent<Procedure>(predicate)](gel::Object* value) {
+    return gel::Truth(runtime->CallPop(predicate.Get(), {value}));
   };
 }
 
@@ -53,9 +54,9 @@ auto CallOnNext(Runtime* runtime, Procedure* proc) -> OnNextFunc {
   if (gel::IsNull(proc))
     return DoNothingOnNext();
   ASSERT(proc);
-  return [runtime, proc](gel::Object* next) {
+  return [runtime, proc = Persistent<Procedure>(proc)](gel::Object* next) {
     ASSERT(next);
-    return runtime->Call(proc, {next});
+    return runtime->Call(proc.Get(), {next});
   };
 }
 
@@ -64,12 +65,12 @@ auto CallOnError(Runtime* runtime, Procedure* proc) -> OnErrorFunc {
   if (gel::IsNull(proc))
     return DoNothingOnError();
   ASSERT(proc);
-  return [runtime, proc](std::exception_ptr error) -> void {
+  return [runtime, proc = Persistent<Procedure>(proc)](std::exception_ptr error) -> void {
     try {
       std::rethrow_exception(error);
     } catch (const Exception& exc) {
       const auto error = Error::New(exc.what());
-      return runtime->Call(proc, {error});
+      return runtime->Call(proc.Get(), {error});
     }
   };
 }
@@ -79,14 +80,14 @@ auto CallOnComplete(Runtime* runtime, Procedure* proc) -> OnCompleteFunc {
   if (gel::IsNull(proc))
     return DoNothingOnComplete();
   ASSERT(proc);
-  return [runtime, proc]() {
-    return runtime->Call(proc);
+  return [runtime, proc = Persistent<Procedure>(proc)]() {
+    return runtime->Call(proc.Get());
   };
 }
 
 auto map(Runtime* runtime, Procedure* proc) -> rpp::operators::details::map_t<std::decay_t<MapFunc>> {
-  const MapFunc func = [runtime, proc](Object* value) {
-    return runtime->CallPop(proc, {value});
+  const MapFunc func = [runtime, proc = Persistent<Procedure>(proc)](Object* value) {
+    return runtime->CallPop(proc.Get(), {value});
   };
   return rpp::operators::map(func);
 }
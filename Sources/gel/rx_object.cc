@@ -347,9 +347,10 @@ NATIVE_RX_PROCEDURE_F(take_while) {
     return ThrowError(fmt::format("expected args to be: `<observable> <func>`"));
   CHECK_ARG_TYPE(0, source, Observable::GetClass());
   CHECK_ARG_TYPE(1, predicate, Procedure::GetClass());
-  source->AsObservable()->Apply(rx::operators::take_while([predicate, runtime](Object* value) {
-    return gel::Truth(runtime->CallPop(predicate->AsProcedure(), {value}));
-  }));
+  source->AsObservable()->Apply(
+      rx::operators::take_while([predicate = Persistent<Procedure>(predicate->AsProcedure()), runtime](Object* value) {
+        return gel::Truth(runtime->CallPop(predicate.Get(), {value}));
+      }));
   return DoNothing();
 }
 
@@ -18,7 +18,9 @@ class Observer : public Object {
 
  protected:
   explicit Observer(rx::DynamicObjectObserver value) :
-    value_(value) {}
+    value_(value) {
+    RegisterFinalizer();
+  }
 
  public:
   ~Observer() override = default;
@@ -56,7 +58,9 @@ class Observable : public Object {
 
  private:
   explicit Observable(const rx::DynamicObjectObservable& value) :
-    value_(value) {}
+    value_(value) {
+    RegisterFinalizer();
+  }
 
  public:
   ~Observable() override = default;
@@ -165,7 +169,9 @@ class TemplateSubject : public Subject {
   S value_{};
 
  protected:
-  TemplateSubject() = default;
+  TemplateSubject() {
+    RegisterFinalizer();
+  }
 
  public:
   ~TemplateSubject() override = default;
@@ -0,0 +1,18 @@
+#include "gel/scheduler.h"
+
+#include "gel/event_loop.h"
+
+namespace gel {
+DEFINE_uword(safepoint_budget, 10000,
+             "The number of backward jumps the interpreter takes between polling the EventLoop, 0 disables polling.");
+
+void Scheduler::RunEventLoop(const uv_run_mode mode) {
+  if (running_)
+    return;
+  const auto loop = GetThreadEventLoop();
+  ASSERT(loop);
+  running_ = true;
+  loop->Run(mode);
+  running_ = false;
+}
+}  // namespace gel
@@ -0,0 +1,58 @@
+#ifndef GEL_SCHEDULER_H
+#define GEL_SCHEDULER_H
+
+#include <uv.h>
+
+#include "gel/common.h"
+#include "gel/flags.h"
+
+namespace gel {
+DECLARE_uword(safepoint_budget);
+
+// runs the thread's EventLoop cooperatively at the interpreter's safepoints: once a top-level Script or expression has
+// finished (Drain), when gel/yield! is called & every `--safepoint_budget` backward jumps.
+class Scheduler {
+  DEFINE_NON_COPYABLE_TYPE(Scheduler);
+
+ private:
+  uword budget_;
+  uword remaining_;
+  bool running_ = false;  // uv_run isn't reentrant, the callbacks it runs don't poll the EventLoop again
+
+  void RunEventLoop(const uv_run_mode mode);
+
+ public:
+  explicit Scheduler(const uword budget = FLAGS_safepoint_budget) :
+    budget_(budget),
+    remaining_(budget) {}
+  ~Scheduler() = default;
+
+  auto GetBudget() const -> uword {
+    return budget_;
+  }
+
+  auto IsRunning() const -> bool {
+    return running_;
+  }
+
+  // counts a backward jump, the EventLoop is polled once the budget runs out. a budget of 0 disables the polling.
+  inline void OnBackEdge() {
+    if (budget_ == 0 || --remaining_ > 0)
+      return;
+    remaining_ = budget_;
+    return Yield();
+  }
+
+  // runs the callbacks that are ready w/o blocking.
+  inline void Yield() {
+    return RunEventLoop(UV_RUN_NOWAIT);
+  }
+
+  // runs the EventLoop until it has no more work.
+  inline void Drain() {
+    return RunEventLoop(UV_RUN_DEFAULT);
+  }
+};
+}  // namespace gel
+
+#endif  // GEL_SCHEDULER_H
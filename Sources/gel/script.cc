@@ -72,6 +72,29 @@ auto Script::VisitPointers(PointerVisitor* vis) -> bool {
   return false;
 }
 
+auto Script::VisitPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  if (!VisitPointer(vis, &name_))
+    return false;
+  for (auto& macro : macros_) {
+    if (!VisitPointer(vis, &macro))
+      return false;
+  }
+  for (auto& lambda : lambdas_) {
+    if (!VisitPointer(vis, &lambda))
+      return false;
+  }
+  for (auto& ns : namespaces_) {
+    if (!VisitPointer(vis, &ns))
+      return false;
+  }
+  for (auto& expr : body_) {
+    if (!VisitPointer(vis, &expr))
+      return false;
+  }
+  return true;
+}
+
 auto Script::FromFile(const std::string& filename, const bool compile) -> Script* {
   DVLOG(10) << "loading script from: " << filename;
   std::stringstream code;
@@ -19,6 +19,7 @@ class Script : public Object, public Executable {
  private:
   LocalScope* scope_;
   String* name_ = nullptr;
+  // std::vectors survive being moved by the collector, their buffers are released once the Script is finalized
   MacroList macros_{};
   LambdaList lambdas_{};
   NamespaceList namespaces_{};
@@ -28,6 +29,7 @@ class Script : public Object, public Executable {
   explicit Script(LocalScope* scope) :
     scope_(scope) {
     ASSERT(scope_);
+    RegisterFinalizer();
   }
 
   void SetName(String* name) {
@@ -61,15 +63,18 @@ class Script : public Object, public Executable {
   void Append(Namespace* ns);
 
   auto VisitPointers(PointerVisitor* vis) -> bool override;
+  auto VisitPointers(PointerPointerVisitor* vis) -> bool override;
 
   void SetExpressionAt(const uint64_t idx, expr::Expression* expr) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
     ASSERT(expr);
+    PreWriteBarrier(body_[idx]);
     body_[idx] = expr;
   }
 
   void RemoveExpressionAt(const uint64_t idx) {
     ASSERT(idx >= 0 && idx <= GetNumberOfExpressions());
+    PreWriteBarrier(body_[idx]);
     body_.erase(at(idx));
   }
 
@@ -90,6 +95,10 @@ class Script : public Object, public Executable {
  public:
   ~Script() override = default;
 
+  auto HasOffHeapPointers() const -> bool override {
+    return true;
+  }
+
   auto GetName() const -> String* {
     return name_;
   }
@@ -39,6 +39,13 @@ auto StackFrame::ToString() const -> std::string {
   return helper;
 }
 
+auto StackFrame::VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool {
+  const auto visit_target = [&vis](auto& target) {
+    return Object::VisitPointer(vis, &target);
+  };
+  return std::visit(visit_target, target_);
+}
+
 StackFrameGuardBase::StackFrameGuardBase(TargetInfoCallback target_info) :
   target_info_(target_info) {
   const auto runtime = GetRuntime();
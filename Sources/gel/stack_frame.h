@@ -2,16 +2,15 @@
 #define GEL_STACK_FRAME_H
 
 #include <ostream>
-#include <stack>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "gel/common.h"
 #include "gel/disassembler.h"
 #include "gel/instruction.h"
 #include "gel/native_procedure.h"
 #include "gel/object.h"
-#include "gel/operation_stack.h"
 #include "gel/platform.h"
 #include "gel/procedure.h"
 #include "gel/type_traits.h"
@@ -31,13 +30,17 @@ class StackFrame {
   TargetVariant target_;
   LocalScope* locals_;
   uword return_address_;
-  OperationStack stack_{};
+  uword base_;        // the index of the frame's first operand in the Runtime's OperationStack
+  uword num_locals_;  // the number of local slots right below the base, 0 when the locals are kept in a LocalScope
 
-  StackFrame(const uword id, const TargetVariant target, LocalScope* locals, const uword return_address = UNALLOCATED) :
+  StackFrame(const uword id, const TargetVariant target, LocalScope* locals, const uword base, const uword num_locals,
+             const uword return_address = UNALLOCATED) :
     id_(id),
     target_(target),
     locals_(locals),
-    return_address_(return_address) {
+    return_address_(return_address),
+    base_(base),
+    num_locals_(num_locals) {
     ASSERT(locals);
   }
 
@@ -50,15 +53,22 @@ class StackFrame {
     id_(0),
     target_(),
     locals_(nullptr),
-    return_address_(UNALLOCATED) {}
+    return_address_(UNALLOCATED),
+    base_(0),
+    num_locals_(0) {}
   ~StackFrame() = default;
 
-  auto stack() const -> const OperationStack& {
-    return stack_;
+  auto GetBase() const -> uword {
+    return base_;
   }
 
-  auto GetOperationStack() -> OperationStack* {
-    return &stack_;
+  auto GetNumberOfLocals() const -> uword {
+    return num_locals_;
+  }
+
+  // the index of the frame's first slot, its locals are popped w/ it.
+  inline auto GetLocalsBase() const -> uword {
+    return GetBase() - GetNumberOfLocals();
   }
 
   auto GetId() const -> uword {
@@ -115,6 +125,8 @@ class StackFrame {
 
   auto GetTargetName() const -> std::string;
   auto ToString() const -> std::string;
+  // visits the target, the operands & locals are visited w/ the Runtime.
+  auto VisitPointers(const std::function<bool(Pointer**)>& vis) -> bool;
   friend auto operator<<(std::ostream& stream, const StackFrame& rhs) -> std::ostream& {
     return stream << rhs.ToString();
   }
@@ -128,21 +140,23 @@ class StackFrameIterator {
   DEFINE_NON_COPYABLE_TYPE(StackFrameIterator);
 
  private:
-  std::stack<StackFrame> stack_;
+  const std::vector<StackFrame>& frames_;
+  uword remaining_;
 
  public:
-  explicit StackFrameIterator(const std::stack<StackFrame>& stack) :
-    stack_(stack) {}
+  // iterates from the innermost frame outwards.
+  explicit StackFrameIterator(const std::vector<StackFrame>& frames) :
+    frames_(frames),
+    remaining_(frames.size()) {}
   ~StackFrameIterator() = default;
 
   auto HasNext() const -> bool {
-    return !stack_.empty();
+    return remaining_ > 0;
   }
 
-  auto Next() -> StackFrame {
-    const auto next = stack_.top();
-    stack_.pop();
-    return next;
+  auto Next() -> const StackFrame& {
+    ASSERT(HasNext());
+    return frames_[--remaining_];
   }
 };
 
@@ -0,0 +1,97 @@
+#include "gel/sweeper.h"
+
+#include "gel/free_list.h"
+#include "gel/heap.h"
+#include "gel/zone.h"
+
+namespace gel {
+auto Sweeper::zone() const -> OldZone& {
+  return heap().old_zone();
+}
+
+void Sweeper::Start() {
+  auto& remembered = heap().remembered_;
+  remembered.erase(std::remove_if(remembered.begin(), remembered.end(),
+                                  [](Pointer* ptr) {
+                                    return !ptr->GetTag().IsMarked();
+                                  }),
+                   remembered.end());
+  // the unmarked Pointers are dead, so the off-heap storage they own is released before they're swept
+  auto& finalizers = heap().old_finalizers_;
+  finalizers.erase(std::remove_if(finalizers.begin(), finalizers.end(),
+                                  [](Pointer* ptr) {
+                                    if (ptr->GetTag().IsMarked())
+                                      return false;
+                                    Heap::Finalize(ptr);
+                                    return true;
+                                  }),
+                   finalizers.end());
+  // new Pointers are only collected by the next minor collection, so only weak references to the old are cleared
+  auto& weak = heap().weak_;
+  weak.erase(std::remove_if(weak.begin(), weak.end(),
+                            [](Pointer* ptr) {
+                              return ptr->GetTag().IsOld() && !ptr->GetTag().IsMarked();
+                            }),
+             weak.end());
+  for (const auto& ptr : weak) {
+    ptr->ClearWeakPointers([this](Pointer** referent) {
+      const auto& tag = (*referent)->GetTag();
+      if (!tag.IsOld() || tag.IsMarked())
+        return true;
+      heap().num_weak_cleared_ += 1;
+      return false;
+    });
+  }
+  // large objects aren't interleaved w/ the zone's free chunks, so they're swept right away
+  bytes_swept_ += heap().large_object_space().Sweep();
+  zone().free_list().ClearBuckets();
+  // Pointers allocated past the end of the zone (e.g. after it grows) are never marked, so they mustn't be swept
+  current_ = zone().GetStartingAddress();
+  end_ = zone().GetEndingAddress();
+  free_start_ = UNALLOCATED;
+}
+
+void Sweeper::Flush(const uword end) {
+  if (free_start_ == UNALLOCATED)
+    return;
+  zone().free_list().Insert(FreePointer::New(free_start_, Tag::Free(end - free_start_ - sizeof(Pointer))));
+  free_start_ = UNALLOCATED;
+}
+
+auto Sweeper::SweepPage() -> bool {
+  if (IsFinished())
+    return false;
+  const auto page_end = current_ + kSweepPageSize;
+  while (current_ < end_) {
+    const auto ptr = Pointer::At(current_);
+    const auto total_size = ptr->GetTotalSize();
+    auto& tag = ptr->tag();
+    if (tag.IsFree()) {
+      if (free_start_ == UNALLOCATED)
+        free_start_ = current_;
+    } else if (tag.IsMarked()) {
+      tag.ClearMarkedBit();
+      Flush(current_);
+      if (current_ >= page_end) {
+        current_ += total_size;
+        return !IsFinished();
+      }
+    } else {
+      num_swept_ += 1;
+      bytes_swept_ += total_size;
+      if (free_start_ == UNALLOCATED)
+        free_start_ = current_;
+    }
+    current_ += total_size;
+  }
+  Flush(end_);
+  DVLOG(1) << "swept " << GetNumberOfPointersSwept() << " pointers ("
+           << units::data::byte_t(static_cast<double>(GetNumberOfBytesSwept())) << ") from: " << zone();
+  return false;
+}
+
+void Sweeper::Finish() {
+  while (!IsFinished())
+    SweepPage();
+}
+}  // namespace gel
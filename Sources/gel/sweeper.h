@@ -1,4 +1,64 @@
 #ifndef GEL_SWEEPER_H
 #define GEL_SWEEPER_H
 
+#include "gel/common.h"
+#include "gel/pointer.h"
+
+namespace gel {
+class Heap;
+class OldZone;
+class Sweeper {
+  DEFINE_NON_COPYABLE_TYPE(Sweeper);
+
+ private:
+  Heap& heap_;
+  uword current_ = UNALLOCATED;
+  uword end_ = UNALLOCATED;
+  uword free_start_ = UNALLOCATED;
+  uword num_swept_ = 0;
+  uword bytes_swept_ = 0;
+
+  inline auto heap() const -> Heap& {
+    return heap_;
+  }
+
+  auto zone() const -> OldZone&;
+  void Flush(const uword end);
+
+ public:
+  explicit Sweeper(Heap& heap) :
+    heap_(heap) {}
+  ~Sweeper() = default;
+
+  auto GetNumberOfPointersSwept() const -> uword {
+    return num_swept_;
+  }
+
+  auto GetNumberOfBytesSwept() const -> uword {
+    return bytes_swept_;
+  }
+
+  static constexpr const uword kSweepPageSize = 64 * 1024;
+
+  auto IsFinished() const -> bool {
+    return current_ >= end_;
+  }
+
+  // drops the unmarked Pointers from the remembered set, sweeps the LargeObjectSpace & empties the FreeList, the zone is
+  // then swept in pages.
+  void Start();
+  // sweeps the next page of the zone, stopping at a marked Pointer so a swept run never borders an unswept free chunk.
+  // returns false once the whole zone has been swept.
+  auto SweepPage() -> bool;
+  // sweeps the rest of the zone.
+  void Finish();
+
+  // returns every unmarked run of the old zone to the FreeList & clears the marked bit of the survivors.
+  inline void Sweep() {
+    Start();
+    Finish();
+  }
+};
+}  // namespace gel
+
 #endif  // GEL_SWEEPER_H
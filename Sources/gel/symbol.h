@@ -25,21 +25,24 @@ class Symbol : public Object {
   };
 
  private:
-  std::string ns_;
-  std::string type_;
-  std::string name_;
+  // off-heap, the small string buffers would dangle once the collector moves the Symbol
+  struct Name {
+    std::string ns;
+    std::string type;
+    std::string name;
+  };
+  std::unique_ptr<Name> name_;
 
   explicit Symbol(const std::string& ns, const std::string& type, const std::string& name) :
     Object(),
-    ns_(ns),
-    type_(type),
-    name_(name) {
-    ASSERT(!name_.empty());
+    name_(std::make_unique<Name>(Name{ns, type, name})) {
+    ASSERT(!name.empty());
+    RegisterFinalizer();
   }
 
   void SetNamespace(const std::string& rhs) {
     ASSERT(!rhs.empty());
-    ns_ = rhs;
+    name_->ns = rhs;
   }
 
   void SetNamespace(Namespace* ns);
@@ -48,23 +51,23 @@ class Symbol : public Object {
   ~Symbol() override = default;
 
   auto GetNamespace() const -> std::string {
-    return ns_;
+    return name_->ns;
   }
 
   inline auto HasNamespace() const -> bool {
-    return !ns_.empty();
+    return !name_->ns.empty();
   }
 
   auto GetSymbolName() const -> const std::string& {
-    return name_;
+    return name_->name;
   }
 
   auto GetSymbolType() const -> const std::string& {
-    return type_;
+    return name_->type;
   }
 
   inline auto HasSymbolType() const -> bool {
-    return !type_.empty();
+    return !name_->type.empty();
   }
 
   auto GetFullyQualifiedName() const -> std::string {
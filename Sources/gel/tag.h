@@ -3,6 +3,9 @@
 
 #include <units.h>
 
+#include <algorithm>
+#include <atomic>
+
 #include "gel/bitfield.h"
 #include "gel/common.h"
 #include "gel/platform.h"
@@ -28,11 +31,16 @@ class Tag {
     kMarkedBitOffset = kOldBitOffset + 1,
     // remembered bit
     kRememberedBitOffset = kMarkedBitOffset + 1,
+    // free bit
+    kFreeBitOffset = kRememberedBitOffset + 1,
+    // age
+    kAgeOffset = kFreeBitOffset + 1,
+    kBitsForAge = 4,
     // size
-    kSizeOffset = kRememberedBitOffset + 1,
+    kSizeOffset = kAgeOffset + kBitsForAge,
     kBitsForSize = 32,
 
-    kTotalNumberOfBits = kBitsForReferences + kBitsForSize + 4,
+    kTotalNumberOfBits = kBitsForReferences + kBitsForAge + kBitsForSize + 5,
   };
 
   template <typename T, const int Pos, const int Size>
@@ -46,12 +54,20 @@ class Tag {
   class OldBit : public TagBit<kOldBitOffset> {};
   class MarkedBit : public TagBit<kMarkedBitOffset> {};
   class RememberedBit : public TagBit<kRememberedBitOffset> {};
+  class FreeBit : public TagBit<kFreeBitOffset> {};
+  class AgeField : public TagField<uword, kAgeOffset, kBitsForAge> {};
   class SizeField : public TagField<uword, kSizeOffset, kBitsForSize> {};
 
  public:
  private:
   RawTag raw_;
 
+  // the marked & remembered bits can be flipped by the concurrent marker & the mutator at the same time.
+  inline auto UpdateBitAtomically(const RawTag mask, const bool value) -> RawTag {
+    std::atomic_ref<RawTag> raw(raw_);
+    return value ? raw.fetch_or(mask, std::memory_order_acq_rel) : raw.fetch_and(~mask, std::memory_order_acq_rel);
+  }
+
  public:
   constexpr Tag(const RawTag raw = kInvalidTag) :
     raw_(raw) {}
@@ -98,7 +114,12 @@ class Tag {
   }
 
   void SetMarkedBit(const bool value = true) {
-    raw_ = MarkedBit::Update(value, raw());
+    UpdateBitAtomically(MarkedBit::Encode(true), value);
+  }
+
+  // returns false if the marked bit was already set.
+  inline auto TrySetMarkedBit() -> bool {
+    return !MarkedBit::Decode(UpdateBitAtomically(MarkedBit::Encode(true), true));
   }
 
   inline void ClearMarkedBit() {
@@ -110,13 +131,37 @@ class Tag {
   }
 
   void SetRememberedBit(const bool value = true) {
-    raw_ = RememberedBit::Update(value, raw());
+    UpdateBitAtomically(RememberedBit::Encode(true), value);
   }
 
   inline void ClearRememberedBit() {
     return SetRememberedBit(false);
   }
 
+  constexpr auto IsFree() const -> bool {
+    return FreeBit::Decode(raw());
+  }
+
+  void SetFreeBit(const bool value = true) {
+    raw_ = FreeBit::Update(value, raw());
+  }
+
+  inline void ClearFreeBit() {
+    return SetFreeBit(false);
+  }
+
+  constexpr auto GetAge() const -> uword {
+    return AgeField::Decode(raw());
+  }
+
+  void SetAge(const uword value) {
+    raw_ = AgeField::Update(std::min(value, kMaxAge), raw());
+  }
+
+  inline void ClearAge() {
+    return SetAge(0);
+  }
+
   constexpr auto GetSize() const -> uword {
     return SizeField::Decode(raw());
   }
@@ -140,12 +185,16 @@ class Tag {
     stream << "new=" << rhs.IsNew() << ", ";
     stream << "old=" << rhs.IsOld() << ", ";
     stream << "marked=" << rhs.IsMarked() << ", ";
-    stream << "remembered=" << rhs.IsRemembered();
+    stream << "remembered=" << rhs.IsRemembered() << ", ";
+    stream << "free=" << rhs.IsFree() << ", ";
+    stream << "age=" << rhs.GetAge();
     stream << ")";
     return stream;
   }
 
  public:
+  static constexpr const uword kMaxAge = (1 << kBitsForAge) - 1;
+
   static inline constexpr auto Invalid() -> Tag {
     return {};
   }
@@ -157,6 +206,15 @@ class Tag {
   static inline constexpr auto Old(const uword size) -> Tag {
     return kInvalidTag | OldBit::Encode(true) | SizeField::Encode(size);
   }
+
+  static inline constexpr auto Free(const uword size) -> Tag {
+    return kInvalidTag | OldBit::Encode(true) | FreeBit::Encode(true) | SizeField::Encode(size);
+  }
+
+  // neither new nor old, for Pointers outside of the heap that are never moved or freed, see ImmortalSpace.
+  static inline constexpr auto Unmanaged(const uword size) -> Tag {
+    return kInvalidTag | SizeField::Encode(size);
+  }
 };
 }  // namespace gel
 
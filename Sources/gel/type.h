@@ -33,6 +33,8 @@ class Definition;
   V(Namespace)                     \
   V(Set)                           \
   V(Map)                           \
+  V(WeakRef)                       \
+  V(WeakMap)                       \
   V(Module)                        \
   V(EventLoop)                     \
   V(Timer)                         \
@@ -0,0 +1,230 @@
+#include "gel/weak_ref.h"
+
+#include "gel/collector.h"
+#include "gel/native_procedure.h"
+#include "gel/natives.h"
+#include "gel/pointer.h"
+#include "gel/to_string_helper.h"
+
+namespace gel {
+// asks `is_alive` whether the referent of `slot` survived & writes it back in case it moved.
+template <class T>
+static inline auto IsAlive(const std::function<bool(Pointer**)>& is_alive, T** slot) -> bool {
+  ASSERT(slot && (*slot));
+  auto ptr = (*slot)->raw_ptr();
+  if (!is_alive(&ptr))
+    return false;
+  (*slot) = ptr->template As<T>();
+  return true;
+}
+
+auto WeakRef::Get() const -> Object* {
+  // the target may be unreachable from the snapshot the concurrent marker is tracing, so it's marked once it's read
+  PreWriteBarrier(target_);
+  return target_;
+}
+
+auto WeakRef::VisitWeakPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  return VisitPointer(vis, &target_);
+}
+
+void WeakRef::ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) {
+  if (target_ && !IsAlive(is_alive, &target_))
+    target_ = nullptr;
+}
+
+// WeakRefs compare by identity, so neither the hash nor equality changes once the target is collected.
+auto WeakRef::HashCode() const -> uword {
+  uword hash = 0;
+  CombineHash(hash, id_);
+  return hash;
+}
+
+auto WeakRef::Equals(Object* rhs) const -> bool {
+  return rhs == this;
+}
+
+auto WeakRef::ToString() const -> std::string {
+  ToStringHelper<WeakRef> helper;
+  helper.AddField("target", (const void*)target_);
+  return helper;
+}
+
+auto WeakRef::CreateClass() -> Class* {
+  ASSERT(kClass == nullptr);
+  return Class::New(Object::GetClass(), "WeakRef");
+}
+
+auto WeakRef::New(Object* target) -> WeakRef* {
+  ASSERT(target);
+  ScopedRoot<Object> root(&target);  // allocating the WeakRef may move the target
+  return new WeakRef(target);
+}
+
+auto WeakRef::New(const ObjectList& args) -> WeakRef* {
+  ASSERT(args.size() == 1);
+  return New(args[0]);
+}
+
+auto WeakMap::Get(Object* key) const -> Object* {
+  ASSERT(key);
+  const auto pos = data().find(key);
+  if (pos == std::end(data()))
+    return Null();
+  PreWriteBarrier(pos->second);
+  return pos->second;
+}
+
+void WeakMap::Put(Object* key, Object* value) {
+  ASSERT(key && value);
+  const auto pos = data_->find(key);
+  if (pos == std::end(*data_)) {
+    data_->insert({key, value});
+    return;
+  }
+  PreWriteBarrier(pos->second);
+  pos->second = value;
+}
+
+auto WeakMap::Remove(Object* key) -> bool {
+  ASSERT(key);
+  const auto pos = data_->find(key);
+  if (pos == std::end(*data_))
+    return false;
+  PreWriteBarrier(pos->second);
+  data_->erase(pos);
+  return true;
+}
+
+// the keys are hashed by value, so a moved key stays in its bucket & is written back in place.
+auto WeakMap::VisitWeakPointers(PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  for (auto& [key, value] : (*data_)) {
+    if (!VisitPointer(vis, const_cast<Object**>(&key)) || !VisitPointer(vis, &value))  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      return false;
+  }
+  return true;
+}
+
+auto WeakMap::VisitEphemerons(const std::function<bool(Pointer**)>& is_alive, PointerPointerVisitor* vis) -> bool {
+  ASSERT(vis);
+  for (auto& [key, value] : (*data_)) {
+    if (IsAlive(is_alive, const_cast<Object**>(&key)) && !VisitPointer(vis, &value))  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      return false;
+  }
+  return true;
+}
+
+// the value of an entry w/ a dead key may be dead too, so it's dropped w/o being looked at.
+void WeakMap::ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) {
+  auto pos = std::begin(*data_);
+  while (pos != std::end(*data_)) {
+    if (!IsAlive(is_alive, const_cast<Object**>(&pos->first))) {  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      pos = data_->erase(pos);
+      continue;
+    }
+    pos++;
+  }
+}
+
+// WeakMaps are only equal to themselves & their address changes when they're moved, so they all share one hash.
+auto WeakMap::HashCode() const -> uword {
+  uword hash = 0;
+  CombineHash(hash, static_cast<uword>(kClassId));
+  return hash;
+}
+
+auto WeakMap::Equals(Object* rhs) const -> bool {
+  return rhs == this;
+}
+
+auto WeakMap::ToString() const -> std::string {
+  ToStringHelper<WeakMap> helper;
+  helper.AddField("size", GetSize());
+  return helper;
+}
+
+auto WeakMap::CreateClass() -> Class* {
+  ASSERT(kClass == nullptr);
+  return Class::New(Object::GetClass(), "WeakMap");
+}
+
+auto WeakMap::New(const ObjectList& args) -> WeakMap* {
+  ASSERT(args.empty() || (args.size() % 2 == 0));
+  const auto map = New();
+  for (auto idx = 0; idx < args.size(); idx += 2)
+    map->Put(args[idx], args[idx + 1]);
+  return map;
+}
+
+namespace proc {
+NATIVE_PROCEDURE_F(weak_ref_get) {
+  NativeArgument<0, WeakRef> ref(args);
+  if (!ref)
+    return Throw(ref);
+  const auto target = ref->Get();
+  return Return(target ? target : Null());
+}
+
+#define WEAK_MAP_PROCEDURE_F(Name) NATIVE_PROCEDURE_F(weak_map_##Name)
+WEAK_MAP_PROCEDURE_F(contains) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  NativeArgument<1> key(args);
+  if (!key)
+    return Throw(key);
+  return ReturnBool(m->Contains(key));
+}
+
+WEAK_MAP_PROCEDURE_F(get) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  NativeArgument<1> key(args);
+  if (!key)
+    return Throw(key);
+  return Return(m->Get(key));
+}
+
+WEAK_MAP_PROCEDURE_F(put) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  NativeArgument<1> key(args);
+  if (!key)
+    return Throw(key);
+  NativeArgument<2> value(args);
+  if (!value)
+    return Throw(value);
+  m->Put(key, value);
+  return Return();
+}
+
+WEAK_MAP_PROCEDURE_F(remove) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  NativeArgument<1> key(args);
+  if (!key)
+    return Throw(key);
+  return ReturnBool(m->Remove(key));
+}
+
+WEAK_MAP_PROCEDURE_F(size) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  return ReturnLong(m->GetSize());
+}
+
+WEAK_MAP_PROCEDURE_F(empty) {
+  NativeArgument<0, WeakMap> m(args);
+  if (!m)
+    return Throw(m);
+  return ReturnBool(m->IsEmpty());
+}
+#undef WEAK_MAP_PROCEDURE_F
+}  // namespace proc
+}  // namespace gel
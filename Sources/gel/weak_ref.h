@@ -0,0 +1,98 @@
+#ifndef GEL_WEAK_REF_H
+#define GEL_WEAK_REF_H
+
+#include <atomic>
+#include <memory>
+
+#include "gel/common.h"
+#include "gel/object.h"
+
+namespace gel {
+// a reference that doesn't keep its target alive, it's cleared once the target is collected.
+class WeakRef : public Object {
+ private:
+  // hands out the ids of new WeakRefs.
+  static inline std::atomic<uword> next_id_{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  Object* target_;
+  uword id_;  // stable identity, unlike the address this survives moves & unlike the target it survives clearing
+
+  explicit WeakRef(Object* target) :
+    Object(),
+    target_(target),
+    id_(next_id_.fetch_add(1, std::memory_order_relaxed)) {
+    RegisterWeakPointers();
+  }
+
+ protected:
+  auto VisitWeakPointers(PointerPointerVisitor* vis) -> bool override;
+  void ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) override;
+
+ public:
+  ~WeakRef() override = default;
+
+  // the target, or null once it's been collected.
+  auto Get() const -> Object*;
+
+  auto IsCleared() const -> bool {
+    return target_ == nullptr;
+  }
+
+  DECLARE_TYPE(WeakRef);
+
+ public:
+  static auto New(Object* target) -> WeakRef*;
+};
+
+// a Map w/ weak keys, each entry is an ephemeron: its value is only kept alive for as long as its key is.
+class WeakMap : public Object {
+ public:
+  using StorageType = Map::StorageType;
+
+ private:
+  std::unique_ptr<StorageType> data_;  // off-heap, the buckets point back into the container
+
+  WeakMap() :
+    Object(),
+    data_(std::make_unique<StorageType>()) {
+    RegisterFinalizer();
+    RegisterWeakPointers();
+  }
+
+ protected:
+  auto VisitWeakPointers(PointerPointerVisitor* vis) -> bool override;
+  void ClearWeakPointers(const std::function<bool(Pointer**)>& is_alive) override;
+  auto VisitEphemerons(const std::function<bool(Pointer**)>& is_alive, PointerPointerVisitor* vis) -> bool override;
+
+ public:
+  ~WeakMap() override = default;
+
+  auto data() const -> const StorageType& {
+    return (*data_);
+  }
+
+  auto GetSize() const -> uword {
+    return data().size();
+  }
+
+  auto IsEmpty() const -> bool {
+    return data().empty();
+  }
+
+  auto Contains(Object* key) const -> bool {
+    return data().contains(key);
+  }
+
+  auto Get(Object* key) const -> Object*;
+  void Put(Object* key, Object* value);
+  auto Remove(Object* key) -> bool;
+  DECLARE_TYPE(WeakMap);
+
+ public:
+  static inline auto New() -> WeakMap* {
+    return new WeakMap();
+  }
+};
+}  // namespace gel
+
+#endif  // GEL_WEAK_REF_H
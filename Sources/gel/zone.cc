@@ -9,6 +9,8 @@
 namespace gel {
 DEFINE_uword(new_zone_size, 4 * 1024 * 1024, "The size of the new zone.");
 DEFINE_uword(old_zone_size, 4 * 1024 * 1024, "The initial size of the old zone (tenured & large object space).");
+DEFINE_bool(huge_pages, true, "Advise the OS to back the zones w/ transparent huge pages.");
+DEFINE_uword(max_heap_size, 512 * 1024 * 1024, "The maximum size the new & old zones can grow to combined.");
 
 using namespace units::data;
 
@@ -17,8 +19,27 @@ static inline auto CalcSemispaceSize(const uword size) -> uword {
   return size / 2;
 }
 
-NewZone::NewZone(const uword size) :
-  Zone(size, MemoryRegion::kReadWrite),
+Zone::Zone(const uword size, const uword max_size, const MemoryRegion::ProtectionMode mode) :
+  Zone(MemoryRegion(std::max(size, max_size), MemoryRegion::kNoAccess)) {
+  mode_ = mode;
+  SetSize(size);
+  MemoryRegion(*this).Protect(mode);
+  if (UseHugePages())
+    MemoryRegion(GetStartingAddress(), GetMaxSize()).AdviseHugePages();
+}
+
+auto Zone::TryGrow(const uword size) -> bool {
+  ASSERT(size > 0);
+  if ((GetSize() + size) > GetMaxSize())
+    return false;
+  MemoryRegion region(GetStartingAddress(), GetMaxSize());
+  region.Protect(GetSize(), size, mode_);
+  SetSize(GetSize() + size);
+  return true;
+}
+
+NewZone::NewZone(const uword size, const uword max_size) :
+  Zone(size, max_size, MemoryRegion::kReadWrite),
   fromspace_(GetStartingAddress()),
   tospace_(GetStartingAddress() + CalcSemispaceSize(size)),
   semi_size_(CalcSemispaceSize(size)) {}
@@ -27,11 +48,8 @@ auto NewZone::TryAllocate(const uword size) -> uword {
   ASSERT(size > 0);
   const auto total_size = (sizeof(Pointer) + size);
   if ((GetCurrentAddress() + total_size) >= (fromspace() + semisize())) {
-    LOG(WARNING) << "cannot allocate " << byte_t(static_cast<double>(total_size)) << " in: " << (*this);
-    // TODO: minor collection
-  }
-  if ((GetCurrentAddress() + total_size) >= (fromspace() + semisize())) {
-    LOG(FATAL) << "cannot allocate " << byte_t(static_cast<double>(total_size)) << " in: " << (*this);
+    DVLOG(1) << "cannot allocate " << byte_t(static_cast<double>(total_size)) << " in: " << (*this);
+    return UNALLOCATED;
   }
   const auto new_address = GetCurrentAddress();
   current_ += total_size;
@@ -40,6 +58,28 @@ auto NewZone::TryAllocate(const uword size) -> uword {
   return ptr->GetObjectAddress();
 }
 
+auto NewZone::TryAllocateBlock(const uword size) -> uword {
+  ASSERT(size > 0);
+  if ((GetCurrentAddress() + size) > (fromspace() + semisize()))
+    return UNALLOCATED;
+  const auto address = GetCurrentAddress();
+  current_ += size;
+  memset((void*)address, 0, size);
+  return address;
+}
+
+void NewZone::ReleaseTospace() {
+  Release(tospace(), semisize());
+}
+
+auto NewZone::TryGrow() -> bool {
+  if (fromspace() != GetStartingAddress() || !Zone::TryGrow(GetSize()))
+    return false;
+  semi_size_ = CalcSemispaceSize(GetSize());
+  tospace_ = fromspace() + semisize();
+  return true;
+}
+
 auto NewZone::VisitAllPointers(PointerVisitor* vis) const -> bool {
   ASSERT(vis);
   Iterator iter(*this);
@@ -67,8 +107,8 @@ auto NewZone::VisitAllMarkedPointers(PointerVisitor* vis) const -> bool {
   return true;
 }
 
-OldZone::OldZone(const uword size) :
-  Zone(size, MemoryRegion::kReadWrite),
+OldZone::OldZone(const uword size, const uword max_size) :
+  Zone(size, max_size, MemoryRegion::kReadWrite),
   free_list_() {
   free_list_ = FreeList(GetStartingAddress(), size);
 }
@@ -78,6 +118,25 @@ auto OldZone::TryAllocate(const uword size) -> uword {
   return free_list_.TryAllocate(size);
 }
 
+auto OldZone::TryGrow(const uword size) -> bool {
+  const auto remaining = GetMaxSize() - GetSize();
+  const auto required = RoundUp(sizeof(Pointer) + size, MemoryRegion::GetPageSize());
+  const auto grow_by = std::min(std::max(GetSize(), required), RoundDown(remaining, MemoryRegion::GetPageSize()));
+  if (grow_by < required || !Zone::TryGrow(grow_by))
+    return false;
+  free_list_.Grow(grow_by);
+  return true;
+}
+
+void OldZone::ReleaseFreePages() {
+  LOG_IF(FATAL, !free_list_.VisitFreePointers([this](FreePointer* ptr) {
+    ASSERT(ptr);
+    Release(ptr->GetStartingAddress() + sizeof(FreePointer), ptr->GetTotalSize() - sizeof(FreePointer));
+    return true;
+  })) << "failed to release free pages in: "
+      << (*this);
+}
+
 #ifdef GEL_DEBUG
 
 using namespace units::data;
@@ -10,15 +10,37 @@
 #include "gel/semispace.h"
 
 namespace gel {
+DECLARE_bool(huge_pages);
+
+static inline auto UseHugePages() -> bool {
+  return FLAGS_huge_pages;
+}
+
+DECLARE_uword(max_heap_size);
+
+static inline auto GetMaxHeapSize() -> uword {
+  return FLAGS_max_heap_size;
+}
+
 class Zone : public AllocationRegion {
   DEFINE_DEFAULT_COPYABLE_TYPE(Zone);
 
+ private:
+  uword max_size_ = 0;  // the size of the address space reserved for the zone
+  MemoryRegion::ProtectionMode mode_ = MemoryRegion::kNoAccess;
+
  protected:
   Zone() = default;
   explicit Zone(const MemoryRegion& region) :
-    AllocationRegion(region.GetStartingAddress(), region.GetSize()) {}
+    AllocationRegion(region.GetStartingAddress(), region.GetSize()),
+    max_size_(region.GetSize()) {}
+  // reserves `max_size` bytes of address space & commits the first `size` bytes w/ `mode`.
+  Zone(const uword size, const uword max_size, const MemoryRegion::ProtectionMode mode);
   explicit Zone(const uword size, const MemoryRegion::ProtectionMode mode = MemoryRegion::kReadOnly) :
-    Zone(MemoryRegion(size, mode)) {}
+    Zone(size, size, mode) {}
+
+  // commits the next `size` bytes of the reservation, growing the zone in place.
+  auto TryGrow(const uword size) -> bool;
 
   void Protect(const MemoryRegion::ProtectionMode mode) {
     MemoryRegion region(*this);
@@ -33,9 +55,19 @@ class Zone : public AllocationRegion {
     return Protect(MemoryRegion::kReadWrite);
   }
 
+  inline void Release(const uword start, const uword size) {
+    ASSERT(start >= GetStartingAddress() && (start + size) <= GetEndingAddress());
+    MemoryRegion region(*this);
+    region.Release(start - GetStartingAddress(), size);
+  }
+
  public:
   ~Zone() override = default;
 
+  auto GetMaxSize() const -> uword {
+    return max_size_;
+  }
+
   friend auto operator<<(std::ostream& stream, const Zone& rhs) -> std::ostream& {
     stream << "Zone(";
     stream << "starting_address=" << rhs.GetStartingAddressPointer() << ", ";
@@ -51,6 +83,14 @@ static inline auto GetNewZoneSize() -> uword {
   return FLAGS_new_zone_size;
 }
 
+// the new zone doubles up to a quarter of the --max_heap_size.
+static inline auto GetMaxNewZoneSize() -> uword {
+  auto size = GetNewZoneSize();
+  while ((size * 2) <= (GetMaxHeapSize() / 4))
+    size *= 2;
+  return size;
+}
+
 class Heap;
 class Collector;
 class NewZone : public Zone {
@@ -70,7 +110,7 @@ class NewZone : public Zone {
     explicit Iterator(const NewZone& new_zone) :
       PointerIterator(),
       new_zone_(new_zone),
-      current_(new_zone.GetStartingAddress()) {}  // TODO: this causes issues when semispaces get flipped from initial positions
+      current_(new_zone.fromspace()) {}
     ~Iterator() override = default;
 
     auto HasNext() const -> bool override {
@@ -90,7 +130,7 @@ class NewZone : public Zone {
   uword tospace_;
   uword semi_size_;
 
-  explicit NewZone(const uword size = GetNewZoneSize());
+  explicit NewZone(const uword size = GetNewZoneSize(), const uword max_size = GetMaxNewZoneSize());
 
   inline void SwapSpaces() {
     std::swap(fromspace_, tospace_);
@@ -121,7 +161,14 @@ class NewZone : public Zone {
 
   auto VisitAllPointers(PointerVisitor* vis) const -> bool;
   auto VisitAllMarkedPointers(PointerVisitor* vis) const -> bool;
+  // hands the pages of the (unused) tospace back to the OS.
+  void ReleaseTospace();
+  // doubles the semispaces in place, only possible while the fromspace is the lower half of the zone.
+  auto TryGrow() -> bool;
   auto TryAllocate(const uword size) -> uword override;
+  // carves a zeroed block of `size` bytes (w/o a Pointer header) out of the fromspace, used to refill a
+  // LocalAllocationBuffer.
+  auto TryAllocateBlock(const uword size) -> uword;
 
   auto GetNumberOfBytesAllocated() const -> uword override {
     return (GetCurrentAddress() - fromspace());
@@ -154,6 +201,14 @@ static inline auto GetOldZoneSize() -> uword {
   return FLAGS_old_zone_size;
 }
 
+static inline auto GetMaxOldZoneSize() -> uword {
+  const auto max_heap_size = GetMaxHeapSize();
+  const auto max_new_zone_size = GetMaxNewZoneSize();
+  if (max_heap_size <= max_new_zone_size)
+    return GetOldZoneSize();
+  return std::max(GetOldZoneSize(), max_heap_size - max_new_zone_size);
+}
+
 class OldZone : public Zone {
   friend class Heap;
   DEFINE_NON_COPYABLE_TYPE(OldZone);
@@ -161,19 +216,37 @@ class OldZone : public Zone {
  private:
   FreeList free_list_;
 
+ protected:
+  void Clear() override {
+    Zone::Clear();
+    free_list_.Reset();
+  }
+
  public:
-  explicit OldZone(const uword size = GetOldZoneSize());
+  explicit OldZone(const uword size = GetOldZoneSize(), const uword max_size = GetMaxOldZoneSize());
   ~OldZone() override = default;
 
+  auto free_list() -> FreeList& {
+    return free_list_;
+  }
+
   auto free_list() const -> const FreeList& {
     return free_list_;
   }
 
   auto TryAllocate(const uword size) -> uword override;
+  // hands the pages spanned by free chunks back to the OS, the chunk headers are kept intact.
+  void ReleaseFreePages();
+  // commits at least `size` more bytes of the reservation & hands them to the free list.
+  auto TryGrow(const uword size) -> bool;
+
+  auto GetNumberOfBytesAllocated() const -> uword override {
+    return free_list_.GetNumberOfBytesAllocated();
+  }
 
   friend auto operator<<(std::ostream& stream, const OldZone& rhs) -> std::ostream& {
     using namespace units::data;
-    stream << "NewZone(";
+    stream << "OldZone(";
     stream << "start=" << rhs.GetStartingAddressPointer() << ", ";
     stream << "size=" << rhs.GetSize() << ", ";
     stream << "allocated=" << byte_t(static_cast<double>(rhs.GetNumberOfBytesAllocated()));
@@ -0,0 +1,79 @@
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "gel/common.h"
+#include "gel/flags.h"
+#include "gel/heap_snapshot.h"
+
+using namespace gel;
+
+DEFINE_uword(top, 20, "The number of classes & retainers to print.");
+
+// the number of dominators printed for each retainer.
+static constexpr const uword kMaxDominatorChainLength = 8;
+
+static inline void PrintClasses(const HeapSnapshotAnalysis& analysis) {
+  const auto classes = analysis.GetClassStats();
+  std::cout << "top classes by retained size:" << std::endl;
+  std::cout << std::setw(10) << "count" << std::setw(16) << "shallow (B)" << std::setw(16) << "retained (B)"
+            << "  class" << std::endl;
+  for (uword idx = 0; idx < std::min(static_cast<uword>(FLAGS_top), static_cast<uword>(classes.size())); idx++) {
+    const auto& cls = classes[idx];
+    std::cout << std::setw(10) << cls.count << std::setw(16) << cls.shallow_size << std::setw(16) << cls.retained_size
+              << "  " << cls.name << std::endl;
+  }
+}
+
+static inline void PrintRetainers(const HeapSnapshotAnalysis& analysis) {
+  const auto& snapshot = analysis.GetSnapshot();
+  std::cout << "top retainers (B):" << std::endl;
+  for (const auto& node : analysis.GetTopRetainers(FLAGS_top)) {
+    std::cout << std::setw(16) << analysis.GetRetainedSize(node) << "  #" << node << " "
+              << snapshot.GetClassName(snapshot.GetNode(node));
+    // the chain of dominators shows what keeps the node alive
+    auto dominator = analysis.GetDominator(node);
+    for (uword idx = 0; dominator != HeapSnapshotAnalysis::kNoDominator; idx++) {
+      if (idx >= kMaxDominatorChainLength) {
+        std::cout << " <- ...";
+        break;
+      }
+      std::cout << " <- #" << dominator << " " << snapshot.GetClassName(snapshot.GetNode(dominator));
+      dominator = analysis.GetDominator(dominator);
+    }
+    std::cout << std::endl;
+  }
+}
+
+auto main(int argc, char** argv) -> int {
+  ::google::InitGoogleLogging(argv[0]);
+  ::google::SetUsageMessage("gel-heap-analyzer [--top=N] <snapshot>");
+  ::google::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc != 2) {
+    std::cerr << "usage: " << ::google::ProgramUsage() << std::endl;
+    return EXIT_FAILURE;
+  }
+  HeapSnapshot snapshot;
+  if (!snapshot.ReadFrom(std::string(argv[1]))) {
+    LOG(ERROR) << "failed to read heap snapshot from: " << argv[1];
+    return EXIT_FAILURE;
+  }
+  const HeapSnapshotAnalysis analysis(snapshot);
+  uword total = 0;
+  uword num_reachable = 0;
+  for (uword idx = 0; idx < snapshot.GetNumberOfNodes(); idx++) {
+    total += snapshot.GetNode(idx).size;
+    if (analysis.IsReachable(idx))
+      num_reachable += 1;
+  }
+  std::cout << "nodes: " << snapshot.GetNumberOfNodes() << " (" << total << "B), ";
+  std::cout << "edges: " << snapshot.GetNumberOfEdges() << ", ";
+  std::cout << "roots: " << snapshot.GetRoots().size() << std::endl;
+  std::cout << "reachable: " << num_reachable << " (" << analysis.GetNumberOfBytesReachable() << "B)" << std::endl;
+  PrintClasses(analysis);
+  PrintRetainers(analysis);
+  return EXIT_SUCCESS;
+}
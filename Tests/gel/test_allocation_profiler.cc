@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "gel/allocation_profiler.h"
+#include "gel/common.h"
+
+namespace gel {
+using namespace ::testing;
+
+class AllocationProfilerTest : public Test {};
+
+TEST_F(AllocationProfilerTest, Test_Consume) {  // NOLINT
+  AllocationProfiler profiler(1024);
+  const auto remaining = profiler.GetBytesUntilSample();
+  ASSERT_GT(remaining, 0);
+  if (remaining > 1)
+    ASSERT_FALSE(profiler.Consume(remaining - 1));
+  ASSERT_TRUE(profiler.Consume(1));
+  ASSERT_EQ(profiler.GetBytesUntilSample(), 0);
+}
+
+TEST_F(AllocationProfilerTest, Test_Sample) {  // NOLINT
+  AllocationProfiler profiler(1024);
+  profiler.Sample("Pair", 32);
+  profiler.Sample("Pair", 32);
+  profiler.Sample("Long", 1 << 20);
+  ASSERT_EQ(profiler.GetNumberOfSamples(), 3);
+  ASSERT_GT(profiler.GetBytesUntilSample(), 0);
+  const auto& sites = profiler.GetSites();
+  ASSERT_EQ(sites.size(), 2);
+  // small objects are scaled up by the inverse of their sampling probability, large ones are always sampled
+  const auto& pairs = sites.at("<root>;Pair");
+  ASSERT_EQ(pairs.num_samples, 2);
+  ASSERT_NEAR(pairs.num_objects, 2 * (1024 / 32), 2);
+  ASSERT_EQ(pairs.num_bytes, pairs.num_objects * 32);
+  const auto& longs = sites.at("<root>;Long");
+  ASSERT_EQ(longs.num_objects, 1);
+  ASSERT_EQ(longs.num_bytes, 1 << 20);
+}
+}  // namespace gel
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "gel/common.h"
+#include "gel/module.h"
+#include "gel/object.h"
+
+namespace gel {
+using namespace ::testing;
+
+class ClassTest : public Test {};
+
+TEST_F(ClassTest, Test_GetAllocationSize) {  // NOLINT
+  ASSERT_EQ(Long::GetClass()->GetAllocationSize(), sizeof(Long));
+  ASSERT_EQ(Pair::GetClass()->GetAllocationSize(), sizeof(Pair));
+  ASSERT_FALSE(Pair::GetClass()->HasFieldOffsets());
+}
+
+TEST_F(ClassTest, Test_Finalize_LaysOutInstanceFields) {  // NOLINT
+  const auto cls = Module::GetClass();
+  ASSERT_TRUE(cls->IsFinalized());
+  ASSERT_EQ(cls->GetAllocationSize(), sizeof(Module) + sizeof(Object*));
+  ASSERT_EQ(cls->GetFieldOffsets().size(), 1);
+  ASSERT_EQ(cls->GetFieldOffsets()[0], sizeof(Module));
+}
+}  // namespace gel
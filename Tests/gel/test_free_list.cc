@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "gel/common.h"
+#include "gel/free_list.h"
+#include "gel/pointer.h"
+#include "gel/zone.h"
+
+namespace gel {
+using namespace ::testing;
+
+class FreeListTest : public Test {
+ protected:
+  static constexpr const uword kZoneSize = 64 * 1024;
+
+  static inline auto GetPointer(const uword address) -> Pointer* {
+    return Pointer::At(address - sizeof(Pointer));
+  }
+};
+
+TEST_F(FreeListTest, Test_New) {  // NOLINT
+  OldZone zone(kZoneSize);
+  const auto& free_list = zone.free_list();
+  ASSERT_EQ(free_list.GetNumberOfBytesFree(), kZoneSize);
+  ASSERT_EQ(free_list.GetNumberOfFreePointers(), 1);
+  ASSERT_EQ(zone.GetNumberOfBytesAllocated(), 0);
+}
+
+TEST_F(FreeListTest, Test_TryAllocate_SplitsChunk) {  // NOLINT
+  static constexpr const uword kObjectSize = 4 * 1024;
+  OldZone zone(kZoneSize);
+  const auto address = zone.TryAllocate(kObjectSize);
+  ASSERT_NE(address, UNALLOCATED);
+  const auto ptr = GetPointer(address);
+  ASSERT_TRUE(ptr->GetTag().IsOld());
+  ASSERT_FALSE(ptr->GetTag().IsFree());
+  ASSERT_EQ(ptr->GetObjectSize(), kObjectSize);
+  const auto& free_list = zone.free_list();
+  ASSERT_EQ(free_list.GetNumberOfFreePointers(), 1);
+  ASSERT_EQ(free_list.GetNumberOfBytesFree(), kZoneSize - ptr->GetTotalSize());
+}
+
+TEST_F(FreeListTest, Test_TryAllocate_Fails_TooLarge) {  // NOLINT
+  OldZone zone(kZoneSize);
+  ASSERT_EQ(zone.TryAllocate(kZoneSize), UNALLOCATED);
+  ASSERT_EQ(zone.free_list().GetNumberOfBytesFree(), kZoneSize);
+}
+
+TEST_F(FreeListTest, Test_TryAllocate_ReusesFreedChunk) {  // NOLINT
+  static constexpr const uword kObjectSize = 128;
+  OldZone zone(kZoneSize);
+  const auto a = zone.TryAllocate(kObjectSize);
+  ASSERT_NE(a, UNALLOCATED);
+  const auto b = zone.TryAllocate(kObjectSize);
+  ASSERT_NE(b, UNALLOCATED);
+  const auto ptr = GetPointer(a);
+  zone.free_list().Free(ptr->GetStartingAddress(), ptr->GetTotalSize());
+  ASSERT_EQ(zone.TryAllocate(kObjectSize), a);
+}
+
+TEST_F(FreeListTest, Test_Coalesce) {  // NOLINT
+  static constexpr const uword kObjectSize = 1024;
+  OldZone zone(kZoneSize);
+  auto& free_list = zone.free_list();
+  const auto a = GetPointer(zone.TryAllocate(kObjectSize));
+  const auto b = GetPointer(zone.TryAllocate(kObjectSize));
+  const auto c = GetPointer(zone.TryAllocate(kObjectSize));
+  free_list.Free(c->GetStartingAddress(), c->GetTotalSize());
+  free_list.Free(a->GetStartingAddress(), a->GetTotalSize());
+  ASSERT_EQ(free_list.GetNumberOfFreePointers(), 2);
+  free_list.Free(b->GetStartingAddress(), b->GetTotalSize());
+  free_list.Coalesce();
+  ASSERT_EQ(free_list.GetNumberOfFreePointers(), 1);
+  ASSERT_EQ(free_list.GetNumberOfBytesFree(), kZoneSize);
+}
+
+TEST_F(FreeListTest, Test_TryAllocate_WithoutCoalescing) {  // NOLINT
+  static constexpr const uword kObjectSize = 1024;
+  OldZone zone(kZoneSize);
+  auto& free_list = zone.free_list();
+  const auto a = GetPointer(zone.TryAllocate(kObjectSize));
+  const auto b = GetPointer(zone.TryAllocate(kObjectSize));
+  ASSERT_NE(zone.TryAllocate(free_list.GetNumberOfBytesFree() - sizeof(Pointer)), UNALLOCATED);
+  free_list.Free(a->GetStartingAddress(), a->GetTotalSize());
+  free_list.Free(b->GetStartingAddress(), b->GetTotalSize());
+  const auto size = a->GetTotalSize() + b->GetTotalSize() - sizeof(Pointer);
+  ASSERT_EQ(free_list.TryAllocate(size, false), UNALLOCATED);
+  ASSERT_EQ(free_list.GetNumberOfFreePointers(), 2);
+  ASSERT_EQ(free_list.TryAllocate(size), a->GetObjectAddress());
+}
+
+TEST_F(FreeListTest, Test_TryGrow) {  // NOLINT
+  OldZone zone(kZoneSize, kZoneSize * 4);
+  ASSERT_EQ(zone.TryAllocate(kZoneSize), UNALLOCATED);
+  ASSERT_TRUE(zone.TryGrow(kZoneSize / 2));
+  ASSERT_EQ(zone.GetSize(), kZoneSize * 2);
+  ASSERT_NE(zone.TryAllocate(kZoneSize), UNALLOCATED);
+  ASSERT_FALSE(zone.TryGrow(kZoneSize * 4));
+}
+}  // namespace gel
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "gel/common.h"
+#include "gel/gc_stats.h"
+
+namespace gel {
+using namespace ::testing;
+
+class GCStatsTest : public Test {};
+
+TEST_F(GCStatsTest, Test_PauseHistogram_GetPercentile) {  // NOLINT
+  PauseHistogram pauses;
+  for (auto idx = 0; idx < 99; idx++)
+    pauses.Record(std::chrono::microseconds(3));
+  pauses.Record(std::chrono::milliseconds(5));
+  ASSERT_EQ(pauses.GetNumberOfPauses(), 100);
+  ASSERT_EQ(pauses.GetBucket(2), 99);
+  ASSERT_EQ(pauses.GetPercentile(50), std::chrono::microseconds(4));
+  ASSERT_EQ(pauses.GetPercentile(99), std::chrono::microseconds(4));
+  ASSERT_EQ(pauses.GetPercentile(100), std::chrono::milliseconds(5));
+  ASSERT_EQ(pauses.GetMaxPause(), std::chrono::milliseconds(5));
+}
+
+TEST_F(GCStatsTest, Test_Record_MinorCollection) {  // NOLINT
+  GCStats stats;
+  GCEvent first(GCEvent::kMinorCollection, std::chrono::microseconds(10));
+  first.allocated = 1000;
+  first.copied = 100;
+  first.promoted = 100;
+  first.freed = 800;
+  stats.Record(first);
+  GCEvent second(GCEvent::kMinorCollection, std::chrono::microseconds(10));
+  second.allocated = 1100;
+  second.copied = 100;
+  stats.Record(second);
+  // the survivors of the first collection aren't allocated twice
+  ASSERT_EQ(stats.GetNumberOfBytesAllocated(), 2000);
+  ASSERT_EQ(stats.GetSurvivalRate(), 14);
+  ASSERT_EQ(stats.GetPauses(GCEvent::kMinorCollection).GetNumberOfPauses(), 2);
+  ASSERT_EQ(stats.GetEvents().size(), 2);
+}
+}  // namespace gel
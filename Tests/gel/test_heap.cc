@@ -0,0 +1,335 @@
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "gel/collector.h"
+#include "gel/common.h"
+#include "gel/compactor.h"
+#include "gel/heap.h"
+#include "gel/heap_verifier.h"
+#include "gel/immortal_space.h"
+#include "gel/lambda.h"
+#include "gel/local.h"
+#include "gel/local_scope.h"
+#include "gel/memory_region.h"
+#include "gel/object.h"
+#include "gel/pointer.h"
+#include "gel/weak_ref.h"
+
+namespace gel {
+using namespace ::testing;
+
+class HeapTest : public Test {
+ protected:
+  static inline auto GetPointer(Object* value) -> Pointer* {
+    return Pointer::At(reinterpret_cast<uword>(value) - sizeof(Pointer));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  static inline auto NewClosure(LocalScope* scope) -> Lambda* {
+    const auto lambda = Lambda::New();
+    lambda->SetScope(scope);
+    return lambda;
+  }
+
+  // allocates a Pair of the rooted `car` & `cdr`, they're only read once allocating the Pair can no longer move them.
+  static inline auto Cons(Object* const* car, Object* const* cdr) -> Pair* {
+    const auto result = Pair::New(Null(), Null());
+    result->SetCar(*car);
+    result->SetCdr(*cdr);
+    return result;
+  }
+
+  // pushes a new Long onto the rooted list `list`.
+  static inline void Push(Object** list, const uint64_t value) {
+    Object* next = Long::New(value);
+    ScopedRoot<Object> root(&next);
+    (*list) = Cons(&next, list);
+  }
+
+  // promotes a rooted list of `num` Longs, which is dropped to leave holes in the old zone for a compaction to fill.
+  static inline void FragmentOldZone(const uword num) {
+    Object* garbage = Null();
+    ScopedRoot<Object> root(&garbage);
+    for (uword idx = 0; idx < num; idx++)
+      Push(&garbage, Long::kMaxSmiValue + idx + 1);
+    for (uword idx = 0; idx < FLAGS_tenure_age; idx++)
+      MinorCollection();
+  }
+};
+
+TEST_F(HeapTest, Test_Allocate_BumpsLocalAllocationBuffer) {  // NOLINT
+  const auto a = Long::New(Long::kMaxSmiValue + 1);
+  const auto b = Long::New(Long::kMaxSmiValue + 2);
+  const auto ptr = GetPointer(a);
+  ASSERT_TRUE(ptr->GetTag().IsNew());
+  ASSERT_EQ(GetPointer(b)->GetStartingAddress(), ptr->GetEndingAddress());
+  ASSERT_EQ(Heap::GetLocalAllocationBuffer().GetCurrentAddress(), GetPointer(b)->GetEndingAddress());
+}
+
+TEST_F(HeapTest, Test_Allocate_LargeObjectBypassesLocalAllocationBuffer) {  // NOLINT
+  const auto& tlab = Heap::GetLocalAllocationBuffer();
+  Long::New(Long::kMaxSmiValue + 1);
+  const auto current = tlab.GetCurrentAddress();
+  const auto address = Heap::Allocate(kLargeObjectSize);
+  ASSERT_NE(address, UNALLOCATED);
+  ASSERT_TRUE(Pointer::At(address - sizeof(Pointer))->GetTag().IsOld());
+  ASSERT_EQ(tlab.GetCurrentAddress(), current);
+}
+
+TEST_F(HeapTest, Test_Allocate_LargeObjectIsPageAligned) {  // NOLINT
+  const auto& large_object_space = Heap::GetHeap()->GetLargeObjectSpace();
+  const auto num_objects = large_object_space.GetNumberOfObjects();
+  const auto address = Heap::Allocate(kLargeObjectSize * 2);
+  ASSERT_NE(address, UNALLOCATED);
+  const auto ptr = Pointer::At(address - sizeof(Pointer));
+  ASSERT_TRUE(large_object_space.Contains(ptr->GetStartingAddress()));
+  ASSERT_EQ(ptr->GetStartingAddress() % MemoryRegion::GetPageSize(), 0);
+  ASSERT_GE(ptr->GetObjectSize(), kLargeObjectSize * 2);
+  ASSERT_EQ(large_object_space.GetNumberOfObjects(), num_objects + 1);
+}
+
+TEST_F(HeapTest, Test_MajorCollection_Compacts) {  // NOLINT
+  static constexpr const uword kNumberOfValues = 64;
+  gflags::FlagSaver saver;
+  FLAGS_tenure_age = 1;
+  FLAGS_compaction_threshold = 0;
+  // the live & dead Pairs are allocated interleaved, so the live ones slide down into the holes left by the dead ones
+  Object* live = Null();
+  ScopedRoot<Object> live_root(&live);
+  Object* dead = Null();
+  ScopedRoot<Object> dead_root(&dead);
+  for (uword idx = 0; idx < kNumberOfValues; idx++) {
+    Push(&live, Long::kMaxSmiValue + idx + 1);
+    Push(&dead, Long::kMaxSmiValue + idx + 1);
+  }
+  MinorCollection();
+  ASSERT_TRUE(GetPointer(live)->GetTag().IsOld());
+  dead = Null();
+  MajorCollection();
+  ASSERT_EQ(Compactor::GetFragmentation(Heap::GetHeap()->GetOldZone().free_list()), 0);
+  auto next = live;
+  for (uword idx = kNumberOfValues; idx > 0; idx--) {
+    ASSERT_TRUE(next->IsPair() && !next->AsPair()->IsEmpty());
+    ASSERT_EQ(Long::Unbox(next->AsPair()->GetCar()), Long::kMaxSmiValue + idx);
+    next = next->AsPair()->GetCdr();
+  }
+  ASSERT_TRUE(next->IsPair() && next->AsPair()->IsEmpty());
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_MajorCollection_ForwardsEveryRoot) {  // NOLINT
+  static constexpr const uword kNumberOfValues = 64;
+  gflags::FlagSaver saver;
+  FLAGS_tenure_age = 1;
+  FLAGS_compaction_threshold = 0;
+  // every root is a separate off-heap slot, each has to be forwarded even though the visitor sees them all through
+  // the same stack copy
+  Object* dead = Null();
+  ScopedRoot<Object> dead_root(&dead);
+  std::vector<Object*> values(kNumberOfValues, Null());
+  std::deque<ScopedRoot<Object>> roots{};
+  for (auto& value : values)
+    roots.emplace_back(&value);
+  for (uword idx = 0; idx < kNumberOfValues; idx++) {
+    Push(&dead, Long::kMaxSmiValue + idx + 1);
+    values[idx] = Long::New(Long::kMaxSmiValue + idx + 1);
+  }
+  MinorCollection();
+  // the dead Pairs are promoted alongside the values, freeing them leaves holes for the values to slide into
+  const auto before = values;
+  dead = Null();
+  MajorCollection();
+  ASSERT_NE(values, before);
+  for (uword idx = 0; idx < kNumberOfValues; idx++) {
+    ASSERT_TRUE(values[idx]->IsLong());
+    ASSERT_EQ(Long::Unbox(values[idx]), Long::kMaxSmiValue + idx + 1);
+  }
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_MajorCollection_SharedScope) {  // NOLINT
+  gflags::FlagSaver saver;
+  FLAGS_tenure_age = 1;
+  FLAGS_compaction_threshold = 0;
+  FragmentOldZone(64);
+  // both closures visit the same LocalVariable, forwarding it twice would leave it pointing into the wrong Pointer
+  const auto scope = LocalScope::New();
+  const auto captured = LocalVariable::New(scope, "x");
+  ASSERT_TRUE(scope->Add(captured));
+  auto first = NewClosure(scope);
+  ScopedRoot<Lambda> first_root(&first);
+  auto second = NewClosure(scope);
+  ScopedRoot<Lambda> second_root(&second);
+  // the closures are the only roots of the value, so it's set once they're rooted
+  captured->SetValue(String::New("captured"));
+  MinorCollection();
+  MajorCollection();
+  for (const auto closure : {first, second}) {
+    LocalVariable* local = nullptr;
+    ASSERT_TRUE(closure->GetScope()->Lookup("x", &local));
+    ASSERT_TRUE(local && local->HasValue() && local->GetValue()->IsString());
+    ASSERT_EQ(local->GetValue()->AsString()->Get(), "captured");
+  }
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_MinorCollection_RememberedSet) {  // NOLINT
+  gflags::FlagSaver saver;
+  FLAGS_tenure_age = 1;
+  auto value = Pair::New(Null(), Null());
+  ScopedRoot<Pair> root(&value);
+  MinorCollection();
+  ASSERT_TRUE(GetPointer(value)->GetTag().IsOld());
+  // the old Pair is the only reference to the new Long, so it survives only if the write barrier remembered the Pair
+  const auto young = Long::New(Long::kMaxSmiValue + 42);
+  value->SetCar(young);
+  ASSERT_TRUE(GetPointer(value->GetCar())->GetTag().IsNew());
+  const auto& remembered = Heap::GetHeap()->GetRememberedSet();
+  ASSERT_NE(std::ranges::find(remembered, GetPointer(value)), std::end(remembered));
+  MinorCollection();
+  ASSERT_TRUE(value->GetCar()->IsLong());
+  ASSERT_EQ(Long::Unbox(value->GetCar()), Long::kMaxSmiValue + 42);
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_MinorCollection_ParallelScavenge) {  // NOLINT
+  static constexpr const uword kNumberOfValues = 16 * 1024;
+  gflags::FlagSaver saver;
+  FLAGS_scavenger_threads = 4;
+  // every entry shares one Long, a scavenger copying it more than once would leave the entries pointing at different copies
+  Object* shared = Long::New(Long::kMaxSmiValue + 1);
+  ScopedRoot<Object> shared_root(&shared);
+  Object* values = Null();
+  ScopedRoot<Object> values_root(&values);
+  for (uword idx = 0; idx < kNumberOfValues; idx++) {
+    Object* entry = Long::New(Long::kMaxSmiValue + idx + 2);
+    ScopedRoot<Object> entry_root(&entry);
+    entry = Cons(&shared, &entry);
+    values = Cons(&entry, &values);
+  }
+  MinorCollection();
+  auto next = values;
+  for (uword idx = kNumberOfValues; idx > 0; idx--) {
+    ASSERT_TRUE(next->IsPair() && !next->AsPair()->IsEmpty());
+    const auto entry = next->AsPair()->GetCar()->AsPair();
+    ASSERT_EQ(entry->GetCar(), shared);
+    ASSERT_EQ(Long::Unbox(entry->GetCdr()), Long::kMaxSmiValue + idx + 1);
+    next = next->AsPair()->GetCdr();
+  }
+  ASSERT_EQ(Long::Unbox(shared), Long::kMaxSmiValue + 1);
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_Verify) {  // NOLINT
+  for (auto idx = 0; idx < 128; idx++)
+    Pair::New(Long::New(idx), Pair::Empty());
+  HeapVerifier before(*Heap::GetHeap());
+  ASSERT_TRUE(before.Verify());
+  MinorCollection();
+  HeapVerifier after(*Heap::GetHeap());
+  ASSERT_TRUE(after.Verify());
+  ASSERT_EQ(after.GetNumberOfErrors(), 0);
+}
+
+TEST_F(HeapTest, Test_Smi) {  // NOLINT
+  auto value = Pair::New(Long::New(42), Long::New(static_cast<uint64_t>(-1)));
+  ScopedRoot<Pair> root(&value);
+  ASSERT_TRUE(IsSmi(value->GetCar()));
+  ASSERT_TRUE(IsSmi(value->GetCdr()));
+  ASSERT_EQ(value->GetCar(), Long::New(42));
+  ASSERT_FALSE(IsSmi(Long::New(Long::kMaxSmiValue + 1)));
+  ASSERT_FALSE(GetPointer(value->GetCar())->GetTag().IsNew());
+  MinorCollection();
+  MajorCollection();
+  ASSERT_EQ(value->GetCar(), Long::New(42));
+  ASSERT_EQ(Long::Unbox(value->GetCar()), 42);
+  HeapVerifier verifier(*Heap::GetHeap());
+  ASSERT_TRUE(verifier.Verify());
+}
+
+TEST_F(HeapTest, Test_Immortal) {  // NOLINT
+  ASSERT_TRUE(ImmortalSpace::IsProtected());
+  ASSERT_TRUE(IsImmortal(Null()));
+  ASSERT_TRUE(IsImmortal(Bool::True()));
+  ASSERT_EQ(Bool::New(false), Bool::False());
+  ASSERT_EQ(String::New(""), String::Empty());
+  ASSERT_EQ(String::New("a"), String::New("a"));
+  ASSERT_TRUE(IsImmortal(String::New("a")));
+  ASSERT_FALSE(IsImmortal(String::New("ab")));
+  ASSERT_EQ(Set::Of(), Set::Empty());
+  ASSERT_EQ(Map::New(), Map::Empty());
+  const auto num_finalizers = Heap::GetHeap()->GetNumberOfFinalizers();
+  String::New("b");
+  ASSERT_EQ(Heap::GetHeap()->GetNumberOfFinalizers(), num_finalizers);
+  MinorCollection();
+  MajorCollection();
+  ASSERT_EQ(String::New("a")->Get(), "a");
+  ASSERT_TRUE(Pair::Empty()->IsEmpty());
+}
+
+TEST_F(HeapTest, Test_Finalize) {  // NOLINT
+  const auto heap = Heap::GetHeap();
+  auto live = String::New("live");
+  ScopedRoot<String> root(&live);
+  MinorCollection();
+  const auto num_finalizers = heap->GetNumberOfFinalizers();
+  String::New("dead");
+  ASSERT_EQ(heap->GetNumberOfFinalizers(), num_finalizers + 1);
+  MinorCollection();
+  ASSERT_EQ(heap->GetNumberOfFinalizers(), num_finalizers);
+  ASSERT_EQ(live->Get(), "live");
+}
+
+TEST_F(HeapTest, Test_WeakPointers) {  // NOLINT
+  const auto heap = Heap::GetHeap();
+  auto live = String::New("live");
+  ScopedRoot<String> live_root(&live);
+  auto ref = WeakRef::New(String::New("dead"));
+  ScopedRoot<WeakRef> ref_root(&ref);
+  auto map = WeakMap::New();
+  ScopedRoot<WeakMap> map_root(&map);
+  {
+    const auto value = String::New("value");
+    map->Put(live, value);
+  }
+  {
+    auto key = String::New("dead-key");
+    ScopedRoot<String> key_root(&key);
+    const auto value = String::New("dead-value");
+    map->Put(key, value);
+  }
+  ASSERT_EQ(map->GetSize(), 2);
+  const auto num_cleared = heap->GetNumberOfWeakPointersCleared();
+  MinorCollection();
+  ASSERT_TRUE(ref->IsCleared());
+  ASSERT_GT(heap->GetNumberOfWeakPointersCleared(), num_cleared);
+  ASSERT_EQ(map->GetSize(), 1);
+  MajorCollection();
+  ASSERT_EQ(map->GetSize(), 1);
+  const auto value = map->Get(live);
+  ASSERT_TRUE(value && value->IsString());
+  ASSERT_EQ(value->AsString()->Get(), "value");
+}
+
+TEST_F(HeapTest, Test_WeakRef_HashCodeSurvivesClearing) {  // NOLINT
+  auto ref = WeakRef::New(String::New("dead"));
+  ScopedRoot<WeakRef> ref_root(&ref);
+  auto other = WeakRef::New(String::New("dead"));
+  ScopedRoot<WeakRef> other_root(&other);
+  const auto hash = ref->HashCode();
+  MinorCollection();
+  ASSERT_TRUE(ref->IsCleared());
+  ASSERT_TRUE(other->IsCleared());
+  ASSERT_EQ(ref->HashCode(), hash);
+  ASSERT_TRUE(ref->Equals(ref));
+  ASSERT_FALSE(ref->Equals(other));
+}
+}  // namespace gel
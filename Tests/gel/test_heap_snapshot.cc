@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "gel/common.h"
+#include "gel/heap_snapshot.h"
+
+namespace gel {
+using namespace ::testing;
+
+class HeapSnapshotTest : public Test {};
+
+TEST_F(HeapSnapshotTest, Test_Dominators) {  // NOLINT
+  HeapSnapshot snapshot;
+  // a diamond: a -> b -> d & a -> c -> d, e is unreachable
+  const auto d = snapshot.AddNode("Long", 40, HeapSnapshot::kNewSpace, {});
+  const auto b = snapshot.AddNode("Pair", 20, HeapSnapshot::kNewSpace, {d});
+  const auto c = snapshot.AddNode("Pair", 30, HeapSnapshot::kOldSpace, {d});
+  const auto a = snapshot.AddNode("Module", 10, HeapSnapshot::kOldSpace, {b, c});
+  const auto e = snapshot.AddNode("Pair", 50, HeapSnapshot::kNewSpace, {a});
+  snapshot.AddRoot(a);
+  const HeapSnapshotAnalysis analysis(snapshot);
+  ASSERT_FALSE(analysis.IsReachable(e));
+  ASSERT_EQ(analysis.GetDominator(a), HeapSnapshotAnalysis::kNoDominator);
+  ASSERT_EQ(analysis.GetDominator(b), a);
+  ASSERT_EQ(analysis.GetDominator(c), a);
+  ASSERT_EQ(analysis.GetDominator(d), a);
+  ASSERT_EQ(analysis.GetRetainedSize(a), 100);
+  ASSERT_EQ(analysis.GetRetainedSize(b), 20);
+  ASSERT_EQ(analysis.GetRetainedSize(d), 40);
+  ASSERT_EQ(analysis.GetNumberOfBytesReachable(), 100);
+  const auto top = analysis.GetTopRetainers(1);
+  ASSERT_EQ(top.size(), 1);
+  ASSERT_EQ(top[0], a);
+}
+
+TEST_F(HeapSnapshotTest, Test_GetClassStats) {  // NOLINT
+  HeapSnapshot snapshot;
+  // a list of three Pairs, only the head's retained size is counted for the Class
+  const auto third = snapshot.AddNode("Pair", 32, HeapSnapshot::kNewSpace, {});
+  const auto second = snapshot.AddNode("Pair", 32, HeapSnapshot::kNewSpace, {third});
+  const auto first = snapshot.AddNode("Pair", 32, HeapSnapshot::kNewSpace, {second});
+  const auto module = snapshot.AddNode("Module", 64, HeapSnapshot::kOldSpace, {first});
+  snapshot.AddRoot(module);
+  const HeapSnapshotAnalysis analysis(snapshot);
+  const auto classes = analysis.GetClassStats();
+  ASSERT_EQ(classes.size(), 2);
+  ASSERT_EQ(classes[0].name, "Module");
+  ASSERT_EQ(classes[0].retained_size, 160);
+  ASSERT_EQ(classes[1].name, "Pair");
+  ASSERT_EQ(classes[1].count, 3);
+  ASSERT_EQ(classes[1].shallow_size, 96);
+  ASSERT_EQ(classes[1].retained_size, 96);
+}
+
+TEST_F(HeapSnapshotTest, Test_WriteTo_ReadFrom) {  // NOLINT
+  HeapSnapshot snapshot;
+  const auto value = snapshot.AddNode("Long", 24, HeapSnapshot::kNewSpace, {});
+  const auto pair = snapshot.AddNode("Pair", 1024, HeapSnapshot::kLargeObjectSpace, {value, value});
+  snapshot.AddRoot(pair);
+  std::stringstream stream;
+  ASSERT_TRUE(snapshot.WriteTo(stream));
+  HeapSnapshot result;
+  ASSERT_TRUE(result.ReadFrom(stream));
+  ASSERT_EQ(result.GetNumberOfNodes(), 2);
+  ASSERT_EQ(result.GetNumberOfEdges(), 2);
+  ASSERT_EQ(result.GetRoots().size(), 1);
+  const auto& node = result.GetNode(result.GetRoots()[0]);
+  ASSERT_EQ(result.GetClassName(node), "Pair");
+  ASSERT_EQ(node.size, 1024);
+  ASSERT_EQ(node.space, HeapSnapshot::kLargeObjectSpace);
+  ASSERT_EQ(result.GetEdge(node, 1), value);
+}
+}  // namespace gel
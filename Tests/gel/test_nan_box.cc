@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "gel/common.h"
+#include "gel/nan_box.h"
+#include "gel/object.h"
+
+namespace gel {
+using namespace ::testing;
+
+class NanBoxTest : public Test {};
+
+TEST_F(NanBoxTest, Test_OfLong) {  // NOLINT
+  const auto value = NanBox::OfLong(static_cast<uint64_t>(-42));
+  ASSERT_TRUE(value.IsLong());
+  ASSERT_TRUE(value.IsNumber());
+  ASSERT_EQ(value.GetLong(), static_cast<uint64_t>(-42));
+  const auto boxed = value.Box();
+  ASSERT_TRUE(boxed && boxed->IsLong());
+  ASSERT_EQ(boxed->AsLong()->Get(), static_cast<uint64_t>(-42));
+}
+
+TEST_F(NanBoxTest, Test_OfLong_StaysBoxed) {  // NOLINT
+  const auto value = NanBox::OfLong(static_cast<uint64_t>(1) << 60);
+  ASSERT_TRUE(value.IsObject());
+  ASSERT_EQ(Long::Unbox(value.GetObject()), static_cast<uint64_t>(1) << 60);
+}
+
+TEST_F(NanBoxTest, Test_Unbox_KeepsLargeLong) {  // NOLINT
+  const auto large = Long::New(static_cast<uint64_t>(1) << 60);
+  const auto value = NanBox::Unbox(large);
+  ASSERT_TRUE(value.IsObject());
+  ASSERT_EQ(value.GetObject(), large);
+}
+
+TEST_F(NanBoxTest, Test_OfDouble) {  // NOLINT
+  const auto value = NanBox::OfDouble(-1.5);
+  ASSERT_TRUE(value.IsDouble());
+  ASSERT_EQ(value.GetDouble(), -1.5);
+  const auto nan = NanBox::OfDouble(-std::numeric_limits<double>::quiet_NaN());
+  ASSERT_TRUE(nan.IsDouble());
+  ASSERT_TRUE(std::isnan(nan.GetDouble()));
+}
+
+TEST_F(NanBoxTest, Test_Unbox) {  // NOLINT
+  ASSERT_TRUE(NanBox::Unbox(Long::New(10)).IsLong());
+  ASSERT_TRUE(NanBox::Unbox(Double::New(1.0)).IsDouble());
+  const auto value = NanBox::Unbox(Bool::True());
+  ASSERT_TRUE(value.IsObject());
+  ASSERT_EQ(value.GetObject(), Bool::True());
+}
+}  // namespace gel
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "gel/common.h"
+#include "gel/object.h"
+#include "gel/operation_stack.h"
+
+namespace gel {
+using namespace ::testing;
+
+class OperationStackTest : public Test {
+ protected:
+  static inline auto New(const uword capacity) -> std::unique_ptr<OperationStack> {
+    return std::unique_ptr<OperationStack>(new OperationStack(capacity));
+  }
+};
+
+TEST_F(OperationStackTest, Test_Push_Grows) {  // NOLINT
+  const auto stack = New(OperationStack::kInitialCommitSize * 4);
+  ASSERT_EQ(stack->GetCommittedCapacity(), OperationStack::kInitialCommitSize);
+  const auto num_values = OperationStack::kInitialCommitSize + 1;
+  for (uword idx = 0; idx < num_values; idx++)
+    stack->Push(Bool::New(idx % 2 == 0));
+  ASSERT_EQ(stack->GetCommittedCapacity(), OperationStack::kInitialCommitSize * 2);
+  ASSERT_EQ(stack->GetStackSize(), num_values);
+  // the slots pushed before growing are still in place
+  for (auto idx = num_values; idx > 0; idx--) {
+    const auto value = stack->Pop();
+    ASSERT_TRUE(value);
+    ASSERT_EQ((*value), Bool::New((idx - 1) % 2 == 0));
+  }
+  ASSERT_TRUE(stack->IsEmpty());
+}
+
+TEST_F(OperationStackTest, Test_Push_Overflow) {  // NOLINT
+  const auto stack = New(OperationStack::kInitialCommitSize);
+  for (uword idx = 0; idx < stack->GetCapacity(); idx++)
+    stack->Push(Null());
+  ASSERT_THROW(stack->Push(Null()), Exception);
+  ASSERT_EQ(stack->GetStackSize(), stack->GetCapacity());
+}
+
+#ifdef GEL_ENABLE_NAN_BOXING
+TEST_F(OperationStackTest, Test_HasError_DoesntBox) {  // NOLINT
+  const auto stack = New(OperationStack::kInitialCommitSize);
+  stack->PushSlot(NanBox::OfLong(42));
+  ASSERT_FALSE(stack->HasError());
+  ASSERT_TRUE(stack->PopSlot().IsLong());
+}
+
+TEST_F(OperationStackTest, Test_Top_BoxesInPlace) {  // NOLINT
+  static constexpr const uint64_t kValue = 1 << 20;  // not a Smi, boxing it allocates
+  const auto stack = New(OperationStack::kInitialCommitSize);
+  stack->PushSlot(NanBox::OfLong(kValue));
+  const auto top = stack->top();
+  ASSERT_TRUE(top->IsLong());
+  ASSERT_EQ(top->AsLong()->Get(), kValue);
+  ASSERT_EQ(stack->top(), top);
+  ASSERT_EQ(stack->PopSlot(), NanBox::Of(top));
+}
+#endif  // GEL_ENABLE_NAN_BOXING
+}  // namespace gel
@@ -1,8 +1,22 @@
+#include <fmt/format.h>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <string>
+
+#include "gel/collector.h"
 #include "gel/common.h"
+#include "gel/flow_graph_compiler.h"
+#include "gel/interpreter.h"
+#include "gel/lambda.h"
+#include "gel/local.h"
+#include "gel/operation_stack.h"
+#include "gel/parser.h"
 #include "gel/runtime.h"
+#include "gel/scheduler.h"
+#include "gel/script.h"
 #include "gel/type_assertions.h"
 #include "gtest/gtest.h"
 
@@ -12,36 +26,175 @@ using namespace ::testing;
 class RuntimeTest : public Test {
   DEFINE_NON_COPYABLE_TYPE(RuntimeTest);
 
- private:
-  Runtime* runtime_ = nullptr;
-
  protected:
   RuntimeTest() = default;
 
-  auto GetRuntime() const -> Runtime* {
-    return runtime_;
+  static inline auto GetRuntime() -> Runtime* {
+    return gel::GetRuntime();
+  }
+
+  static inline auto Parse(const std::string& code) -> Script* {
+    std::istringstream stream(code);
+    const auto script = Parser::ParseScript(stream);
+    ASSERT(script);
+    LOG_IF(FATAL, !FlowGraphCompiler::Compile(script, GetRuntime()->GetScope())) << "failed to compile: " << code;
+    return script;
+  }
+
+  static inline auto Exec(const std::string& code) -> Object* {
+    return Runtime::Exec(Parse(code));
+  }
+
+  static inline auto GetLambda(Script* script, const std::string& name) -> Lambda* {
+    LocalVariable* local = nullptr;
+    LOG_IF(FATAL, !script->GetScope()->Lookup(name, &local) || !local->HasValue()) << "failed to find: " << name;
+    return local->GetValue()->AsLambda();
+  }
+
+  static inline auto IsLong(Object* rhs, const uint64_t expected) -> AssertionResult {
+    if (!rhs || !rhs->IsLong())
+      return AssertionFailure() << "expected " << (rhs ? rhs->ToString() : "null") << " to be a Long.";
+    if (Long::Unbox(rhs) != expected)
+      return AssertionFailure() << "expected " << rhs->ToString() << " to be: " << expected;
+    return AssertionSuccess();
+  }
+
+  // the args are bound to `(cons a (cons b c))` or `(cons a b)` w/o the optional `c`.
+  static inline auto IsArgs(Object* rhs, const uint64_t a, const uint64_t b) -> AssertionResult {
+    if (!rhs || !rhs->IsPair())
+      return AssertionFailure() << "expected " << (rhs ? rhs->ToString() : "null") << " to be a Pair.";
+    const auto car = IsLong(rhs->AsPair()->GetCar(), a);
+    return car ? IsLong(rhs->AsPair()->GetCdr(), b) : car;
+  }
+
+  static inline auto IsArgs(Object* rhs, const uint64_t a, const uint64_t b, const uint64_t c) -> AssertionResult {
+    if (!rhs || !rhs->IsPair())
+      return AssertionFailure() << "expected " << (rhs ? rhs->ToString() : "null") << " to be a Pair.";
+    const auto car = IsLong(rhs->AsPair()->GetCar(), a);
+    return car ? IsArgs(rhs->AsPair()->GetCdr(), b, c) : car;
+  }
+
+  static inline auto GetOperands() -> const OperationStack& {
+    return GetRuntime()->operands_;
   }
 
-  inline auto SetRuntime(Runtime* rhs) -> Runtime* {
-    const auto old = GetRuntime();
-    runtime_ = rhs;
-    return old;
+  // the deepest the StackFrames have been so far, rounded up by the vector holding them.
+  static inline auto GetMaxStackDepth() -> uword {
+    return GetRuntime()->frames_.capacity();
   }
 
  public:
   ~RuntimeTest() override = default;
 
   void SetUp() override {
-    ASSERT_FALSE(runtime_);
-    runtime_ = Runtime::New();
-    ASSERT_TRUE(runtime_);
+    ASSERT_TRUE(GetRuntime());
+    ASSERT_FALSE(GetRuntime()->HasStackFrame());
   }
+};
 
-  void TearDown() override {
-    ASSERT_TRUE(runtime_);
-    delete runtime_;
-    runtime_ = nullptr;
-    ASSERT_FALSE(runtime_);
+TEST_F(RuntimeTest, Test_Exec_Dispatch) {  // NOLINT
+  static constexpr const auto kProgram =
+      "(def x 10)\n"
+      "(def total 0)\n"
+      "(while (> x 0)\n"
+      "  (set! total (+ total (* x 2)))\n"
+      "  (set! x (- x 1)))\n"
+      "(cond (eq? total 110) (- total 10) total)";
+  gflags::FlagSaver saver;
+  // threaded dispatch falls back to the switch when the interpreter wasn't built w/ it
+  for (const auto threaded : {true, false}) {
+    FLAGS_threaded_dispatch = threaded;
+    const auto result = Exec(kProgram);
+    ASSERT_TRUE(result && result->IsLong()) << "threaded_dispatch=" << threaded;
+    ASSERT_EQ(Long::Unbox(result), 100) << "threaded_dispatch=" << threaded;
   }
-};
-}  // namespace gel
\ No newline at end of file
+}
+
+static constexpr const auto kArgs = "(defn args [a b c?] (cond (null? c) (cons a b) (cons a (cons b c))))\n";
+
+TEST_F(RuntimeTest, Test_Exec_PositionalArgs) {  // NOLINT
+  static constexpr const auto kProgram =
+      "(defn sub [a b c] (- (- a b) c))\n"
+      "(cons (sub 10 3 2) (args 1 2 3))";
+  const auto result = Exec(fmt::format("{}{}", kArgs, kProgram));
+  ASSERT_TRUE(result && result->IsPair());
+  ASSERT_TRUE(IsLong(result->AsPair()->GetCar(), 5));
+  ASSERT_TRUE(IsArgs(result->AsPair()->GetCdr(), 1, 2, 3));
+}
+
+TEST_F(RuntimeTest, Test_Exec_OptionalArgs) {  // NOLINT
+  const auto result = Exec(fmt::format("{}(cons (args 1 2) (args 4 5 6))", kArgs));
+  ASSERT_TRUE(result && result->IsPair());
+  ASSERT_TRUE(IsArgs(result->AsPair()->GetCar(), 1, 2));
+  ASSERT_TRUE(IsArgs(result->AsPair()->GetCdr(), 4, 5, 6));
+}
+
+TEST_F(RuntimeTest, Test_Call_Lambda) {  // NOLINT
+  auto script = Parse(fmt::format("{}(args 0 0)", kArgs));
+  ScopedRoot<Script> root(&script);
+  auto lambda = GetLambda(script, "args");
+  ScopedRoot<Lambda> lambda_root(&lambda);
+  ASSERT_TRUE(IsArgs(GetRuntime()->CallPop(lambda, {Long::New(1), Long::New(2), Long::New(3)}), 1, 2, 3));
+  ASSERT_TRUE(IsArgs(GetRuntime()->CallPop(lambda, {Long::New(4), Long::New(5)}), 4, 5));
+  ASSERT_FALSE(GetRuntime()->HasStackFrame());
+  ASSERT_TRUE(GetOperands().IsEmpty());
+}
+
+TEST_F(RuntimeTest, Test_Exec_TailCall) {  // NOLINT
+  static constexpr const auto kCountdown = "(defn countdown [n] (cond (eq? n 0) n (countdown (- n 1))))\n";
+  // a call one level deep sets the high-water marks the tail calls below must stay under
+  ASSERT_EQ(Long::Unbox(Exec(fmt::format("{}(countdown 1)", kCountdown))), 0);
+  const auto max_depth = GetMaxStackDepth();
+  const auto committed = GetOperands().GetCommittedCapacity();
+  // w/o tail calls every level would take at least a slot, so this overflows the OperationStack
+  const auto depth = GetOperands().GetCapacity() * 4;
+  const auto result = Exec(fmt::format("{}(countdown {})", kCountdown, depth));
+  ASSERT_TRUE(result && result->IsLong());
+  ASSERT_EQ(Long::Unbox(result), 0);
+  ASSERT_EQ(GetMaxStackDepth(), max_depth);
+  ASSERT_EQ(GetOperands().GetCommittedCapacity(), committed);
+  ASSERT_FALSE(GetRuntime()->HasStackFrame());
+  ASSERT_TRUE(GetOperands().IsEmpty());
+}
+
+TEST_F(RuntimeTest, Test_Exec_TailCallFromScript) {  // NOLINT
+  // the call is in tail position of the Script, which has no Lambda frame to replace
+  static constexpr const auto kProgram =
+      "(defn add-one [n] (+ n 1))\n"
+      "(add-one 41)";
+  const auto result = Exec(kProgram);
+  ASSERT_TRUE(result && result->IsLong());
+  ASSERT_EQ(Long::Unbox(result), 42);
+  ASSERT_FALSE(GetRuntime()->HasStackFrame());
+  ASSERT_TRUE(GetOperands().IsEmpty());
+}
+
+TEST_F(RuntimeTest, Test_Scheduler_Yield) {  // NOLINT
+  static constexpr const auto kProgram =
+      "(def ticks 0)\n"
+      "(create-timer (fn [] (set! ticks (+ ticks 1))) 0 0)\n"
+      "(gel/yield!)\n"
+      "(+ ticks 0)";
+  // the result is taken before the EventLoop is drained, so the timer must've run from gel/yield!
+  const auto result = Exec(kProgram);
+  ASSERT_TRUE(result && result->IsLong());
+  ASSERT_EQ(Long::Unbox(result), 1);
+}
+
+TEST_F(RuntimeTest, Test_Scheduler_BackEdge) {  // NOLINT
+  const auto budget = GetRuntime()->GetScheduler()->GetBudget();
+  if (budget == 0)
+    GTEST_SKIP() << "--safepoint_budget=0 disables polling";
+  // the budget may be partially used up already, looping `budget` times is guaranteed to exhaust it
+  const auto program = fmt::format(
+      "(def ticks 0)\n"
+      "(def n {})\n"
+      "(create-timer (fn [] (set! ticks (+ ticks 1))) 0 0)\n"
+      "(while (> n 0) (set! n (- n 1)))\n"
+      "(+ ticks 0)",
+      budget + 1);
+  const auto result = Exec(program);
+  ASSERT_TRUE(result && result->IsLong());
+  ASSERT_EQ(Long::Unbox(result), 1);
+}
+}  // namespace gel
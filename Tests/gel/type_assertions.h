@@ -14,6 +14,7 @@
 #include "gel/rx.h"
 #include "gel/script.h"
 #include "gel/symbol.h"
+#include "gel/weak_ref.h"
 
 namespace gel::testing {
 using namespace ::testing;
@@ -4,15 +4,22 @@
 #include "gel/gel.h"
 #include "gel/heap.h"
 #include "gel/object.h"
+#include "gel/operation_stack.h"
+#include "gel/parser.h"
+#include "gel/runtime.h"
 
 using namespace gel;
 
 auto main(int argc, char** argv) -> int {
   ::google::InitGoogleLogging(argv[0]);
   ::testing::InitGoogleTest(&argc, argv);
+  // a small operand stack lets the tests recurse past its capacity quickly
+  FLAGS_operation_stack_size = OperationStack::kInitialCommitSize;
   ::google::ParseCommandLineFlags(&argc, &argv, false);
   LOG(INFO) << "Running unit tests for scheme v" << gel::GetVersion() << "....";
+  Parser::Init();
   Heap::Init();
-  Object::Init();
+  // the collectors visit the Runtime's roots
+  Runtime::Init();
   return RUN_ALL_TESTS();
 }
\ No newline at end of file
@@ -22,6 +22,16 @@ if(DISABLE_HEAP_ALLOCATOR)
   add_compile_definitions(GEL_DISABLE_HEAP)
 endif()
 
+option(ENABLE_NAN_BOXING "Keep the interpreter's numeric operands NaN-boxed." OFF)
+if(ENABLE_NAN_BOXING)
+  add_compile_definitions(GEL_ENABLE_NAN_BOXING)
+endif()
+
+option(ENABLE_THREADED_DISPATCH "Dispatch bytecodes w/ computed gotos when the compiler supports them." ON)
+if(ENABLE_THREADED_DISPATCH)
+  add_compile_definitions(GEL_ENABLE_THREADED_DISPATCH)
+endif()
+
 option(ENABLE_LAMBDA_CACHE "Enable the lambda cache" ON)
 if(ENABLE_LAMBDA_CACHE)
   add_compile_definitions(GEL_ENABLE_LAMBDA_CACHE)
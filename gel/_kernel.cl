@@ -66,6 +66,10 @@
     "Returns whether or not this is a debug instance of gelrt.")
   (defnative gel/load-bindings [filename]
     "Opens the bindings from shared library at path [filename].")
+  (defnative gel/gc-stats []
+    "Returns an association list of the garbage collector's pause times, survival & allocation rates.")
+  (defnative gel/heap-snapshot [filename]
+    "Writes a snapshot of the heap to [filename] (or heap.snapshot in the reports directory) for gel-heap-analyzer.")
   (defnative format [pattern args...] ;; TODO: move to gel/ namespace
       "Returns a formatted String using the supplied [pattern] and [args...].")
   (defnative print [value] ;; TODO: move to gel/ namespace
@@ -102,6 +106,8 @@
   ;; ---------------------------------------------------------------------------------
   (defnative get-event-loop []
     "Returns the EventLoop for the current thread.")
+  (defnative gel/yield! []
+    "Runs the EventLoop callbacks that are ready w/o blocking.")
   ;; ---------------------------------------------------------------------------------
 
   ;; ---------------------------------------------------------------------------------